@@ -0,0 +1,547 @@
+/******************************************************************************
+* Program:   Lift simulation library (host stand-in)
+* Filename:  Footprint.c
+* Version:   1.2
+* Date:      16.10.2026
+*
+* Description:
+* Flash, RAM and EEPROM footprint of an AVR build. Reads the linker map
+* (avr-gcc -Wl,-Map, as written by Atmel Studio next to the .elf/.lss) and
+* lists the size of every function and variable the linker kept:
+*
+*   flash   .text + .data (initial values)
+*   ram     .data + .bss + .noinit, the stack comes on top
+*   eeprom  .eeprom
+*
+* The report is compared with a baseline file of the build configuration:
+* every symbol that grew or shrank is listed, and the run fails when a
+* total or a symbol exceeds its budget. A baseline file holds lines
+*
+*   budget <flash|ram|eeprom|symbol> <bytes>
+*   total  <flash|ram|eeprom> <bytes>
+*   <text|data|bss|noinit|eeprom> <bytes> <symbol>
+*
+* and comments (#). A budget of a total with a + (flash+, ram+, eeprom+)
+* is the growth allowed over the total of the baseline, so the gate fails
+* long before the chip is full. -u writes the report to the baseline and
+* keeps its budgets; a new baseline gets the limits of the ATmega32 and
+* the default growth.
+*
+* A baseline without a report (no total lines) waits for the first build
+* of the current sources: -n says the map was just linked (the PostBuild
+* step of the Atmel Studio projects) and writes the report. Without -n
+* such a baseline is an error, a map lying around may be older than the
+* sources.
+*
+*   Footprint [-u] [-n] [-v] <map> <baseline>   -v also lists every symbol
+*
+* Exit status: 0 within the budgets, 1 error or no baseline report yet,
+* 2 a budget is exceeded.
+*
+*******************************************************************************/
+
+/*** INCLUDE FILES ************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+
+/*** OWN DEFINES **************************************************************/
+#define SYMBOLS_MAX         2048
+#define BUDGETS_MAX         64
+#define NAME_MAX            80
+#define LINE_MAX            512
+
+// ATmega32: 32 KB flash, 2 KB RAM of which 512 bytes are kept for the
+// stack, 1 KB EEPROM
+#define DEFAULT_FLASH       32768
+#define DEFAULT_RAM         1536
+#define DEFAULT_EEPROM      1024
+
+// growth of the totals before the baseline has to be updated
+#define DEFAULT_FLASH_GROWTH    512
+#define DEFAULT_RAM_GROWTH      64
+#define DEFAULT_EEPROM_GROWTH   32
+
+#define MAP_START           "Linker script and memory map"
+
+
+/*** OWN DATA TYPES ***********************************************************/
+typedef enum {KindText = 0, KindData, KindBss, KindNoinit, KindEeprom, KINDS, KindNone = KINDS}
+KindType;
+
+typedef enum {TotalFlash = 0, TotalRam, TotalEeprom, TOTALS}
+TotalType;
+
+typedef struct
+{
+	KindType  kind;
+	char      name[NAME_MAX];
+	char      object[NAME_MAX];
+	uint32_t  size;
+} SymbolType;
+
+typedef struct
+{
+	char      name[NAME_MAX];     // flash, ram, eeprom or a symbol
+	uint32_t  size;
+} BudgetType;
+
+typedef struct
+{
+	SymbolType  symbols[SYMBOLS_MAX];
+	uint32_t    count;
+	uint32_t    sections[KINDS];  // output section sizes
+	uint32_t    totals[TOTALS];
+} ReportType;
+
+
+/*** GLOBAL Variablen *********************************************************/
+static const char *kindNames[KINDS]   = {"text", "data", "bss", "noinit", "eeprom"};
+static const char *totalNames[TOTALS] = {"flash", "ram", "eeprom"};
+
+static ReportType  current;
+static ReportType  baseline;
+static uint8_t     hasReport;     // the baseline has its totals
+static BudgetType  budgets[BUDGETS_MAX];
+static uint32_t    budgetCount;
+
+
+/*******************************************************************************
+***  PRIVATE FUNCTIONS  ********************************************************
+*******************************************************************************/
+// Output section of a map line name, KindNone for the ones not counted
+static KindType SectionKind (const char *name)
+{
+	for (KindType kind = 0; kind < KINDS; kind++)
+	{
+		if (name[0] == '.' && strcmp(name + 1, kindNames[kind]) == 0)
+		{
+			return kind;
+		}
+	}
+	return KindNone;
+}
+
+// Add the size of a symbol, entries of the same name are summed up
+static void AddSymbol (ReportType *report, KindType kind, const char *name, const char *object, uint32_t size)
+{
+	SymbolType *symbol;
+
+	for (uint32_t i = 0; i < report->count; i++)
+	{
+		symbol = &report->symbols[i];
+		if (symbol->kind == kind && strcmp(symbol->name, name) == 0)
+		{
+			symbol->size += size;
+			return;
+		}
+	}
+	if (report->count == SYMBOLS_MAX)
+	{
+		fprintf(stderr, "footprint: more than %d symbols\n", SYMBOLS_MAX);
+		exit(1);
+	}
+	symbol = &report->symbols[report->count++];
+	symbol->kind = kind;
+	symbol->size = size;
+	snprintf(symbol->name, sizeof symbol->name, "%s", name);
+	snprintf(symbol->object, sizeof symbol->object, "%s", object);
+}
+
+// Symbol of an input section: .text.SetOutput -> SetOutput, sections
+// without a name of their own are named after their object
+static void SymbolName (char *name, const char *section, KindType kind, const char *object)
+{
+	size_t prefix = strlen(kindNames[kind]) + 2;   // ".text."
+
+	if (strncmp(section + 1, kindNames[kind], prefix - 2) == 0 && section[prefix - 1] == '.')
+	{
+		snprintf(name, NAME_MAX, "%s", section + prefix);
+	}
+	else
+	{
+		// library.a(member.o): the member is enough
+		const char *member = strchr(object, '(');
+		int        length = member ? (int)strcspn(member + 1, ")") : (int)strlen(object);
+
+		// both halves fit into the name: ".init4(_copy_data.o)"
+		if (length > NAME_MAX / 2 - 2)
+		{
+			length = NAME_MAX / 2 - 2;
+		}
+		snprintf(name, NAME_MAX, "%.*s(%.*s)", NAME_MAX / 2 - 1, section, length, member ? member + 1 : object);
+	}
+}
+
+// File name of the object column: library.a(member.o) or file.o
+static const char *ObjectName (const char *path)
+{
+	const char *name = path;
+
+	for (const char *c = path; *c; c++)
+	{
+		if (*c == '/' || *c == '\\')
+		{
+			name = c + 1;
+		}
+	}
+	return name;
+}
+
+// Read the memory map part of a linker map
+static int ReadMap (const char *path, ReportType *report)
+{
+	FILE      *file = fopen(path, "r");
+	char      line[LINE_MAX];
+	char      section[NAME_MAX] = "";
+	KindType  kind = KindNone;
+	int       started = 0;
+
+	if (!file)
+	{
+		perror(path);
+		return 0;
+	}
+
+	while (fgets(line, sizeof line, file))
+	{
+		char     name[NAME_MAX];
+		char     symbol[NAME_MAX];
+		char     object[LINE_MAX] = "";
+		unsigned address;
+		unsigned size;
+		int      used = 0;
+		int      fields;
+
+		line[strcspn(line, "\r\n")] = '\0';
+		if (!started)
+		{
+			// the discarded input sections before it look alike
+			started = strncmp(line, MAP_START, strlen(MAP_START)) == 0;
+			continue;
+		}
+
+		if (line[0] == '.')
+		{
+			// output section: ".text  0x00000000  0x848", the numbers may
+			// be on the next line for a long name
+			fields = sscanf(line, "%79s %x %x", name, &address, &size);
+			kind = SectionKind(name);
+			if (kind != KindNone && fields == 3)
+			{
+				report->sections[kind] = size;
+			}
+			section[0] = '\0';
+			continue;
+		}
+		if (kind == KindNone)
+		{
+			continue;
+		}
+
+		if (line[0] == ' ' && (line[1] == '.' || strncmp(line + 1, "COMMON", 6) == 0))
+		{
+			// input section: " .text.SetOutput  0x00000484  0x21e  library.o"
+			fields = sscanf(line, " %79s %x %x %n", section, &address, &size, &used);
+			if (fields == 1)
+			{
+				continue;  // the numbers follow on the next line
+			}
+		}
+		else if (section[0] != '\0' && line[0] == ' ')
+		{
+			// continued input section: "      0x00000484  0x21e  library.o"
+			fields = sscanf(line, " %x %x %n", &address, &size, &used) + 1;
+		}
+		else
+		{
+			continue;
+		}
+
+		if (fields == 3 && used > 0)
+		{
+			snprintf(object, sizeof object, "%s", ObjectName(line + used));
+			if (size > 0)
+			{
+				SymbolName(symbol, section, kind, object);
+				AddSymbol(report, kind, symbol, object, size);
+			}
+		}
+		section[0] = '\0';
+	}
+	fclose(file);
+
+	if (!started)
+	{
+		fprintf(stderr, "%s: not a linker map\n", path);
+		return 0;
+	}
+	report->totals[TotalFlash]  = report->sections[KindText] + report->sections[KindData];
+	report->totals[TotalRam]    = report->sections[KindData] + report->sections[KindBss] + report->sections[KindNoinit];
+	report->totals[TotalEeprom] = report->sections[KindEeprom];
+	return 1;
+}
+
+// Read the budgets and the report of a baseline file, missing file = none
+static void ReadBaseline (const char *path, ReportType *report)
+{
+	FILE  *file = fopen(path, "r");
+	char  line[LINE_MAX];
+
+	if (!file)
+	{
+		return;
+	}
+
+	while (fgets(line, sizeof line, file))
+	{
+		char      word[NAME_MAX];
+		char      name[NAME_MAX];
+		unsigned  size;
+		KindType  kind;
+
+		if (line[0] == '#' || sscanf(line, "%79s", word) != 1)
+		{
+			continue;
+		}
+		if (strcmp(word, "budget") == 0 && sscanf(line, "%*s %79s %u", name, &size) == 2)
+		{
+			if (budgetCount < BUDGETS_MAX)
+			{
+				snprintf(budgets[budgetCount].name, NAME_MAX, "%s", name);
+				budgets[budgetCount++].size = size;
+			}
+			continue;
+		}
+		if (strcmp(word, "total") == 0 && sscanf(line, "%*s %79s %u", name, &size) == 2)
+		{
+			for (TotalType total = 0; total < TOTALS; total++)
+			{
+				if (strcmp(name, totalNames[total]) == 0)
+				{
+					report->totals[total] = size;
+					hasReport = 1;
+				}
+			}
+			continue;
+		}
+		for (kind = 0; kind < KINDS && strcmp(word, kindNames[kind]) != 0; kind++)
+		{
+		}
+		if (kind < KINDS && sscanf(line, "%*s %u %79s", &size, name) == 2)
+		{
+			AddSymbol(report, kind, name, "", size);
+		}
+	}
+	fclose(file);
+}
+
+// Size of a symbol of the report, 0 if it is not there
+static uint32_t FindSymbol (const ReportType *report, KindType kind, const char *name)
+{
+	for (uint32_t i = 0; i < report->count; i++)
+	{
+		if (report->symbols[i].kind == kind && strcmp(report->symbols[i].name, name) == 0)
+		{
+			return report->symbols[i].size;
+		}
+	}
+	return 0;
+}
+
+// Largest symbols first
+static int CompareSize (const void *a, const void *b)
+{
+	const SymbolType *left = a;
+	const SymbolType *right = b;
+
+	if (left->size != right->size)
+	{
+		return (left->size < right->size) ? 1 : -1;
+	}
+	return strcmp(left->name, right->name);
+}
+
+// Write the report with the budgets to the baseline file
+static int WriteBaseline (const char *path, const char *map)
+{
+	FILE *file = fopen(path, "w");
+
+	if (!file)
+	{
+		perror(path);
+		return 0;
+	}
+	if (budgetCount == 0)
+	{
+		uint32_t defaults[TOTALS] = {DEFAULT_FLASH, DEFAULT_RAM, DEFAULT_EEPROM};
+		uint32_t growths[TOTALS]  = {DEFAULT_FLASH_GROWTH, DEFAULT_RAM_GROWTH, DEFAULT_EEPROM_GROWTH};
+
+		for (TotalType total = 0; total < TOTALS; total++)
+		{
+			snprintf(budgets[budgetCount].name, NAME_MAX, "%s", totalNames[total]);
+			budgets[budgetCount++].size = defaults[total];
+		}
+		for (TotalType total = 0; total < TOTALS; total++)
+		{
+			snprintf(budgets[budgetCount].name, NAME_MAX, "%s+", totalNames[total]);
+			budgets[budgetCount++].size = growths[total];
+		}
+	}
+
+	fprintf(file, "# Footprint baseline of %s\n", map);
+	fprintf(file, "# make footprint checks the budgets, make footprint-update writes the rest\n");
+	for (uint32_t i = 0; i < budgetCount; i++)
+	{
+		fprintf(file, "budget  %-24s %6lu\n", budgets[i].name, (unsigned long)budgets[i].size);
+	}
+	for (TotalType total = 0; total < TOTALS; total++)
+	{
+		fprintf(file, "total   %-24s %6lu\n", totalNames[total], (unsigned long)current.totals[total]);
+	}
+	for (uint32_t i = 0; i < current.count; i++)
+	{
+		fprintf(file, "%-7s %6lu  %s\n", kindNames[current.symbols[i].kind],
+		        (unsigned long)current.symbols[i].size, current.symbols[i].name);
+	}
+	fclose(file);
+	return 1;
+}
+
+
+/*******************************************************************************
+*** MAIN PROGRAM
+*******************************************************************************/
+int main (int argc, char *argv[])
+{
+	int       update = 0;
+	int       built = 0;
+	int       verbose = 0;
+	int       over = 0;
+	int       changes = 0;
+	int       arg = 1;
+
+	for (; arg < argc && argv[arg][0] == '-'; arg++)
+	{
+		update  |= strcmp(argv[arg], "-u") == 0;
+		built   |= strcmp(argv[arg], "-n") == 0;
+		verbose |= strcmp(argv[arg], "-v") == 0;
+	}
+	if (argc - arg != 2)
+	{
+		fprintf(stderr, "usage: %s [-u] [-n] [-v] <map> <baseline>\n", argv[0]);
+		return 1;
+	}
+	if (!ReadMap(argv[arg], &current))
+	{
+		return 1;
+	}
+	ReadBaseline(argv[arg + 1], &baseline);
+	qsort(current.symbols, current.count, sizeof(SymbolType), CompareSize);
+
+	printf("%s\n", argv[arg]);
+	for (TotalType total = 0; total < TOTALS; total++)
+	{
+		printf("  %-7s %6lu", totalNames[total], (unsigned long)current.totals[total]);
+		if (hasReport)
+		{
+			printf("  %+6ld to baseline", (long)current.totals[total] - (long)baseline.totals[total]);
+		}
+		printf("\n");
+	}
+
+	// symbols that changed since the baseline
+	if (hasReport)
+	{
+		for (uint32_t i = 0; i < current.count; i++)
+		{
+			const SymbolType *symbol = &current.symbols[i];
+			uint32_t         before = FindSymbol(&baseline, symbol->kind, symbol->name);
+
+			if (symbol->size != before)
+			{
+				printf("  %-7s %+6ld  %s%s\n", kindNames[symbol->kind], (long)symbol->size - (long)before,
+				       symbol->name, before == 0 ? " (new)" : "");
+				changes++;
+			}
+		}
+		for (uint32_t i = 0; i < baseline.count; i++)
+		{
+			const SymbolType *symbol = &baseline.symbols[i];
+
+			if (FindSymbol(&current, symbol->kind, symbol->name) == 0)
+			{
+				printf("  %-7s %+6ld  %s (gone)\n", kindNames[symbol->kind], -(long)symbol->size, symbol->name);
+				changes++;
+			}
+		}
+		if (changes == 0)
+		{
+			printf("  no symbol changed\n");
+		}
+	}
+
+	if (verbose)
+	{
+		for (uint32_t i = 0; i < current.count; i++)
+		{
+			printf("  %-7s %6lu  %-32s %s\n", kindNames[current.symbols[i].kind],
+			       (unsigned long)current.symbols[i].size, current.symbols[i].name, current.symbols[i].object);
+		}
+	}
+
+	// budgets of the totals, of their growth and of single symbols
+	fflush(stdout);
+	for (uint32_t i = 0; i < budgetCount; i++)
+	{
+		size_t    length = strlen(budgets[i].name);
+		int       growth = length > 1 && budgets[i].name[length - 1] == '+';
+		uint32_t  size = 0;
+		uint32_t  before = 0;
+
+		for (TotalType total = 0; total < TOTALS; total++)
+		{
+			if (strlen(totalNames[total]) == length - growth
+			    && strncmp(budgets[i].name, totalNames[total], length - growth) == 0)
+			{
+				size   = current.totals[total];
+				before = baseline.totals[total];
+			}
+		}
+		if (growth)
+		{
+			// no growth without a report to grow from
+			if (hasReport && size > before + budgets[i].size)
+			{
+				fprintf(stderr, "footprint: %s: %.*s grew by %lu bytes, budget %lu\n", argv[arg],
+				        (int)length - 1, budgets[i].name, (unsigned long)(size - before),
+				        (unsigned long)budgets[i].size);
+				over = 1;
+			}
+			continue;
+		}
+		for (KindType kind = 0; kind < KINDS; kind++)
+		{
+			size += FindSymbol(&current, kind, budgets[i].name);
+		}
+		if (size > budgets[i].size)
+		{
+			fprintf(stderr, "footprint: %s: %s %lu bytes, budget %lu\n", argv[arg], budgets[i].name,
+			        (unsigned long)size, (unsigned long)budgets[i].size);
+			over = 1;
+		}
+	}
+
+	if (!hasReport && !update && !built)
+	{
+		fprintf(stderr, "footprint: %s: no report yet, build the project in Atmel Studio\n", argv[arg + 1]);
+		return 1;
+	}
+	if ((update || (built && !hasReport)) && !WriteBaseline(argv[arg + 1], argv[arg]))
+	{
+		return 1;
+	}
+	return over ? 2 : 0;
+}
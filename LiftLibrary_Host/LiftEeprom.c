@@ -0,0 +1,187 @@
+/******************************************************************************
+* Program:   Lift simulation library (host stand-in)
+* Filename:  LiftEeprom.c
+* Version:   1.0
+* Date:      16.10.2026
+*
+* Description:
+* EEPROM image of the host simulation, see LiftEeprom.h and avr/eeprom.h.
+* Reads cost a few cycles, a write of a changed byte keeps the EEPROM busy
+* for EEPROM_WRITE_US; a write while it is busy waits for it first.
+*
+* Required Libraries:
+* - LiftSim.h
+* - LiftEeprom.h
+*
+*******************************************************************************/
+
+/*** INCLUDE FILES ************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <avr/eeprom.h>
+#include "LiftSim.h"
+#include "LiftEeprom.h"
+
+
+/*** OWN DEFINES **************************************************************/
+#define EEPROM_SIZE         (E2END + 1)
+#define ERASED              0xFF
+
+// approximate cycles of the avr-libc functions
+#define READ_CYCLES         8
+#define WRITE_CYCLES        12
+
+
+/*** GLOBAL Variablen *********************************************************/
+static uint8_t     image[EEPROM_SIZE];
+static uint32_t    writes[EEPROM_SIZE];
+static uint64_t    busyUntil;            // end of the running write [us]
+static const char  *imagePath;
+
+
+/*******************************************************************************
+***  PRIVATE FUNCTIONS  ********************************************************
+*******************************************************************************/
+// EEPROM address of a pointer, the run ends on a wrong one
+static uint16_t Address (const void *pointer, size_t size)
+{
+	uintptr_t address = (uintptr_t)pointer;
+
+	if (address + size > EEPROM_SIZE)
+	{
+		fprintf(stderr, "liftsim: EEPROM access 0x%lx (%lu bytes) beyond E2END\n",
+		        (unsigned long)address, (unsigned long)size);
+		exit(1);
+	}
+	return (uint16_t)address;
+}
+
+// Write one byte as the EEPROM control would
+static void Write (uint16_t address, uint8_t value)
+{
+	LiftEepromBusyWait();
+	LiftSimCharge(WRITE_CYCLES);
+	image[address] = value;
+	writes[address]++;
+	busyUntil = LiftSimMicros() + EEPROM_WRITE_US;
+}
+
+
+/*******************************************************************************
+***  PUBLIC FUNCTIONS  *********************************************************
+*******************************************************************************/
+// Load the image
+void LiftEepromInit (void)
+{
+	FILE *file;
+
+	memset(image, ERASED, sizeof image);
+	imagePath = getenv("LIFTSIM_EEPROM");
+	if (imagePath && *imagePath && (file = fopen(imagePath, "rb")) != NULL)
+	{
+		if (fread(image, 1, sizeof image, file) != sizeof image)
+		{
+			fprintf(stderr, "liftsim: %s is no EEPROM image, starting erased\n", imagePath);
+			memset(image, ERASED, sizeof image);
+		}
+		fclose(file);
+	}
+}
+
+// Save the image and print the write statistics
+void LiftEepromReport (void)
+{
+	uint32_t total = 0;
+	uint32_t most = 0;
+	FILE     *file;
+
+	for (uint16_t address = 0; address < EEPROM_SIZE; address++)
+	{
+		total += writes[address];
+		most = (writes[address] > most) ? writes[address] : most;
+	}
+	if (total)
+	{
+		fprintf(stderr, "liftsim: eeprom %lu bytes written, at most %lu times to one address\n",
+		        (unsigned long)total, (unsigned long)most);
+	}
+
+	if (imagePath && *imagePath)
+	{
+		if ((file = fopen(imagePath, "wb")) == NULL || fwrite(image, 1, sizeof image, file) != sizeof image)
+		{
+			fprintf(stderr, "liftsim: cannot write %s\n", imagePath);
+		}
+		if (file)
+		{
+			fclose(file);
+		}
+	}
+}
+
+// No write in progress
+uint8_t LiftEepromReady (void)
+{
+	return LiftSimMicros() >= busyUntil;
+}
+
+// Wait for the running write
+void LiftEepromBusyWait (void)
+{
+	uint64_t us = LiftSimMicros();
+
+	if (us < busyUntil)
+	{
+		LiftSimDelay((uint32_t)(busyUntil - us));
+	}
+}
+
+uint8_t eeprom_read_byte (const uint8_t *address)
+{
+	uint16_t index = Address(address, 1);
+
+	LiftEepromBusyWait();
+	LiftSimCharge(READ_CYCLES);
+	return image[index];
+}
+
+void eeprom_read_block (void *destination, const void *source, size_t size)
+{
+	uint16_t index = Address(source, size);
+
+	LiftEepromBusyWait();
+	LiftSimCharge((uint16_t)(READ_CYCLES * size));
+	memcpy(destination, &image[index], size);
+}
+
+void eeprom_write_byte (uint8_t *address, uint8_t value)
+{
+	Write(Address(address, 1), value);
+}
+
+void eeprom_update_byte (uint8_t *address, uint8_t value)
+{
+	uint16_t index = Address(address, 1);
+
+	LiftSimCharge(READ_CYCLES);
+	if (image[index] != value)
+	{
+		Write(index, value);
+	}
+}
+
+void eeprom_update_block (const void *source, void *destination, size_t size)
+{
+	uint16_t       index = Address(destination, size);
+	const uint8_t  *bytes = source;
+
+	for (size_t i = 0; i < size; i++)
+	{
+		LiftSimCharge(READ_CYCLES);
+		if (image[index + i] != bytes[i])
+		{
+			Write(index + i, bytes[i]);
+		}
+	}
+}
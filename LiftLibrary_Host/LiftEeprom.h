@@ -0,0 +1,37 @@
+/******************************************************************************
+* Program:   Lift simulation library (host stand-in)
+* Filename:  LiftEeprom.h
+* Version:   1.0
+* Date:      16.10.2026
+*
+* Description:
+* EEPROM of the host simulation behind avr/eeprom.h.
+*
+* Configuration (environment variables, see also LiftSim.h):
+* - LIFTSIM_EEPROM     file that holds the EEPROM image: read at the start
+*                      if it exists, written at the end of the run. Without
+*                      it every run starts with an erased EEPROM.
+*
+* The summary counts the bytes written and the most writes of one address
+* (the cells of the ATmega32 last about 100000 writes).
+*
+*******************************************************************************/
+#ifndef LIFTEEPROM_H_
+#define LIFTEEPROM_H_
+
+/*** INCLUDE FILES ************************************************************/
+#include <stdint.h>
+
+
+/*** OWN DEFINES **************************************************************/
+#define EEPROM_WRITE_US     8500    // erase and write of one byte
+
+
+/*** PUBLIC FUNCTIONS *********************************************************/
+// Load the image (LiftSimInit)
+void LiftEepromInit (void);
+
+// Save the image and print the write statistics to stderr
+void LiftEepromReport (void);
+
+#endif /* LIFTEEPROM_H_ */
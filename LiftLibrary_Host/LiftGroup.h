@@ -0,0 +1,58 @@
+/******************************************************************************
+* Program:   Lift simulation library (host stand-in)
+* Filename:  LiftGroup.h
+* Version:   1.2
+* Date:      16.10.2026
+*
+* Description:
+* Group extension of the host library: up to LIFT_CARS_MAX cars in one
+* building, and shafts with more floors than the board. Every car has its
+* own cabin, doors, display, LEDs and cabin buttons; the floor buttons are
+* shared and show up in the high nibble of every car's button port. The library calls and
+* PIND refer to the selected car, car 0 is selected at start, so a
+* controller for one car and four floors does not need this header.
+*
+* The shaft of the model has LIFT_FLOORS floors with LIFT_STEPS_PER_FLOOR
+* positions each, four floors with 16 positions like the board unless the
+* build defines them (make -B FLOORS=N STEPS=M passes them to the
+* controller and the model alike). Floors above the four of PIND are read
+* with LiftReadCarButtons(). LiftLibrary.h stays the V4 interface: with
+* more than four floors its Error, Test and None are floor numbers, the
+* controller keeps its own values for them.
+*
+* Scenario lines name the car of a cabin button as "<ButtonType>@<car>",
+* e.g. "LiftButton_F2@1" (see LiftSim.h).
+*
+* Precondition:  InitializePorts() has been called
+*
+* Postcondition: -
+*
+*******************************************************************************/
+#ifndef LIFTGROUP_H_
+#define LIFTGROUP_H_
+
+/*** INCLUDE FILES ************************************************************/
+#include <stdint.h>
+
+
+/*** OWN DEFINES **************************************************************/
+#define LIFT_CARS_MAX       8
+
+#ifndef LIFT_FLOORS
+#define LIFT_FLOORS         4
+#endif
+
+#ifndef LIFT_STEPS_PER_FLOOR
+#define LIFT_STEPS_PER_FLOOR 16
+#endif
+
+
+/*** PUBLIC FUNCTIONS *********************************************************/
+// Following library calls and PIND refer to this car
+void LiftSelectCar (uint8_t car);
+
+// Buttons of a car without selecting it, one bit per floor: the cabin
+// buttons of the car and the (shared) floor buttons; for the ISR
+void LiftReadCarButtons (uint8_t car, uint64_t *cabin, uint64_t *floor);
+
+#endif /* LIFTGROUP_H_ */
@@ -0,0 +1,104 @@
+/******************************************************************************
+* Program:   Lift simulation library (host stand-in)
+* Filename:  LiftLibrary.h
+* Version:   4.0-host
+* Date:      16.10.2026
+*
+* Description:
+* Interface of the lift model library. The types, enumerator values and
+* prototypes are identical to LiftLibrary_V4 so that every main.c of the
+* solution builds unchanged against either the ATmega32 library or the
+* host simulation in this directory.
+*
+* Precondition:  -
+*
+* Postcondition: -
+*
+* Required Libraries:
+* - avr/io.h (host register shim in LiftLibrary_Host/avr)
+*
+*******************************************************************************/
+#ifndef LIFTLIBRARY_H_
+#define LIFTLIBRARY_H_
+
+/*** INCLUDE FILES ************************************************************/
+#include <avr/io.h>
+
+
+/*** OWN DATA TYPES ***********************************************************/
+// door select lines on PORTC (low nibble)
+enum {Floor0_D = 1, Floor1_D = 2, Floor2_D = 4, Floor3_D = 8};
+
+// buttons on PIND (lift cabin buttons in low nibble, floor buttons in high)
+typedef enum {EmergencyButton = 0,
+              LiftButton_F0 = 1, LiftButton_F1 = 2, LiftButton_F2 = 4, LiftButton_F3 = 8,
+              FloorButton_F0 = 16, FloorButton_F1 = 32, FloorButton_F2 = 64, FloorButton_F3 = 128}
+ButtonType;
+
+// door LED pattern on PORTC (high nibble)
+typedef enum {Door100 = 0xF0, Door75 = 0x70, Door50 = 0x30, Door25 = 0x10, Door00 = 0x00}
+DoorPosType;
+
+typedef enum {Closed = 0, Moves, Open}
+DoorStateType;
+
+typedef enum {On = 0, Off}
+DisplayStateType;
+
+typedef enum {Released = 0, Pressed}
+ButtonStateType;
+
+typedef enum {Floor0 = 0, Floor1, Floor2, Floor3, Error, Test = 6, None,
+              LiftMoves = 100, LiftStopped, UpperStop = 200, Overload = 210}
+LiftPosType;
+
+typedef enum {Down = 0, Up}
+DirectionType;
+
+typedef enum {Stop = 0, Slow = 4000, Medium = 2000, Fast = 1000}
+SpeedType;
+
+
+/*** PUBLIC FUNCTIONS *********************************************************/
+// Initialization of the ports (PORTA..C outputs, PORTD button inputs)
+void InitializePorts (void);
+
+// Set start state of the system (doors closed, cabin between Floor1 and Floor2)
+void InitializeStart (void);
+
+// Send the calculated output values to the ports (call once per loop pass)
+void SetOutput (void);
+
+// Read the state of a single button
+ButtonStateType ReadKeyEvent (ButtonType button);
+
+// Read the state of the door on the given floor
+DoorStateType ReadDoorState (LiftPosType floor);
+
+// Request the door on the given floor to open or close
+void SetDoorState (DoorStateType state, LiftPosType floor);
+
+// Move the cabin one call further in the given direction
+void MoveElevator (DirectionType direction, SpeedType speed);
+
+// Read the cabin position (Floor0..Floor3, LiftMoves, LiftStopped, UpperStop)
+LiftPosType ReadElevatorState (void);
+
+// Move the cabin towards Floor0 (call until ReadElevatorState() == Floor0)
+void CalibrateElevatorPosition (void);
+
+// Show a value on the 7-segment display of the cabin
+void SetDisplay (LiftPosType displayValue);
+
+// Switch the call indicator LED of a floor button on/off
+void SetIndicatorFloorState (LiftPosType floor);
+void ClrIndicatorFloorState (LiftPosType floor);
+
+// Switch the call indicator LED of a cabin button on/off
+void SetIndicatorElevatorState (LiftPosType floor);
+void ClrIndicatorElevatorState (LiftPosType floor);
+
+// Light all outputs for a hardware test
+void TestLiftsimulator (void);
+
+#endif /* LIFTLIBRARY_H_ */
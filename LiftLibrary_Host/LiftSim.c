@@ -0,0 +1,1102 @@
+/******************************************************************************
+* Program:   Lift simulation library (host stand-in)
+* Filename:  LiftSim.c
+* Version:   1.11
+* Date:      16.10.2026
+*
+* Description:
+* Simulated clock, timers, button scenario and run statistics of the host
+* simulation. See LiftSim.h for the configuration variables.
+*
+* Precondition:  LiftSimInit() is called by InitializePorts()
+*
+* Postcondition: the process exits once the simulated run time is over and
+*                prints a summary to stderr
+*
+* Required Libraries:
+* - LiftSim.h
+* - LiftGroup.h
+* - LiftTraffic.h
+* - LiftEeprom.h
+*
+*******************************************************************************/
+
+/*** INCLUDE FILES ************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "LiftSim.h"
+#include "LiftGroup.h"
+#include "LiftTraffic.h"
+#include "LiftEeprom.h"
+
+
+/*** OWN DEFINES **************************************************************/
+#define DEFAULT_HOLD_MS     200
+#define DEFAULT_TAIL_S      60
+#define NEVER               UINT64_MAX
+#define TIMERS              2
+#define FLOORS              LIFT_FLOORS
+#define KEYS                (2 * FLOORS)  // cabin buttons, then floor buttons
+#define JAMS                (FLOORS + 1)  // doors, then the cabin
+#define PIND_FLOORS         ((FLOORS < 4) ? FLOORS : 4)
+#define CYCLES_PER_US       (F_CPU / 1000000UL)
+
+// interrupt response, register save/restore and reti; charged to the clock,
+// so the main loop picks a tick up this late at the earliest
+#define ISR_CYCLES          40
+
+// watchdog timeout of WDTO_15MS, doubled by every further WDTO_* value
+#define WATCHDOG_BASE_US    16300
+
+// approximate supply current of the ATmega32 at 8 MHz / 5 V
+#define ACTIVE_MA           11.0
+#define IDLE_MA             5.0
+
+
+/*** OWN DATA TYPES ***********************************************************/
+typedef enum {ButtonArrival = 0, ButtonRelease, TrafficDue, JamStart, JamEnd, WakeUp}
+SimEventKind;
+
+typedef struct
+{
+	uint64_t     at;      // due time [cycles]
+	SimEventKind kind;
+	uint32_t     arg;     // car * KEYS + key, passed on for TrafficDue,
+	                      // car * JAMS + door or cabin for the jams
+} SimEventType;
+
+// timer in CTC mode, counting CPU cycles
+typedef struct
+{
+	volatile uint8_t *control;       // register with the CS bits
+	uint8_t          interruptBit;   // enable bit in TIMSK, flag bit in TIFR
+	void             (*vector)(void);
+	uint8_t          clock;          // CS bits the due time was computed for
+	uint16_t         top;            // compare value the due time was computed for
+	uint64_t         lastMatch;      // cycle of the last compare match
+	uint64_t         due;            // cycle of the next compare match
+} SimTimerType;
+
+
+/*** GLOBAL Variablen *********************************************************/
+volatile uint8_t PORTA, DDRA, PINA;
+volatile uint8_t PORTB, DDRB, PINB;
+volatile uint8_t PORTC, DDRC, PINC;
+volatile uint8_t PORTD, DDRD, PIND;
+volatile uint8_t  TCCR0, TCNT0, OCR0, TIMSK, TIFR, MCUCR, MCUCSR = _BV(PORF);
+volatile uint8_t  TCCR1A, TCCR1B;
+volatile uint16_t TCNT1, OCR1A;
+
+// interrupt vectors of the controller, if it has any
+void TIMER0_COMP_vect (void) __attribute__((weak));
+void TIMER1_COMPA_vect (void) __attribute__((weak));
+
+static SimTimerType timers[TIMERS] =
+{
+	{ &TCCR0,  OCIE0,  TIMER0_COMP_vect,  0, 0, 0, NEVER },
+	{ &TCCR1B, OCIE1A, TIMER1_COMPA_vect, 0, 0, 0, NEVER }
+};
+
+static const uint16_t prescalers[8] = { 0, 1, 8, 64, 256, 1024, 0, 0 };
+
+static uint64_t  now;                 // simulated time [cycles]
+static uint64_t  endTime;             // end of the run [cycles]
+static uint64_t  chargedCycles;       // CPU time used since the clock last moved
+static uint32_t  holdUs;
+static uint8_t   verbose;
+static uint8_t   skipIdle = 1;
+static uint8_t   interruptsOn;        // global interrupt flag (I bit)
+static uint64_t  timerDue = NEVER;    // next compare match of all timers
+
+// event queue (binary min-heap on the due time)
+static SimEventType *queue;
+static uint32_t  queueCount;
+static uint32_t  queueCapacity;
+static uint64_t  nextEvent = NEVER;   // due time of the queue head
+
+// number of presses currently holding each button, the floor buttons are
+// shared by all cars and counted at car 0
+static uint8_t   pressDepth[LIFT_CARS_MAX][KEYS];
+
+// button ports of every car: PIND image and one bit per floor
+static uint8_t   carPins[LIFT_CARS_MAX];
+static uint64_t  carCabinKeys[LIFT_CARS_MAX];
+static uint64_t  carFloorKeys[LIFT_CARS_MAX];
+
+// cars the controller has selected so far, and the selected one
+static uint8_t   carsUsed = 1;
+static uint8_t   selectedCar;
+
+// SetOutput() calls of every car, skipped ones included
+static uint64_t  carPasses[LIFT_CARS_MAX];
+
+// SetOutput() call of the car that finishes a moving door, 0 = door at rest
+static uint64_t  doorDeadline[LIFT_CARS_MAX][FLOORS];
+
+// what the controller did since it last woke up, see LiftSimSleep()
+static uint64_t  wakeStartActive;
+static uint64_t  wakeStartGroup;
+static uint64_t  wakeStartPasses[LIFT_CARS_MAX];
+static uint64_t  wakeStartMoves[LIFT_CARS_MAX];
+static uint64_t  repeatDeclared;      // wake-ups declared alike since the last wake-up
+static uint8_t   repeatWakeUps;       // consecutive wake-ups that were declared alike
+
+// cycles and library calls of every car in the last wake-up
+static uint64_t  lastWakeCycles;
+static uint64_t  lastWakeGroup;
+static uint64_t  wakePasses[LIFT_CARS_MAX];
+static uint64_t  wakeMoves[LIFT_CARS_MAX];
+
+// closed form of the tick interrupt of the controller
+static void      (*repeatInterrupt)(uint32_t matches);
+
+// free running controllers: cost of the last loop pass and whether the
+// controller declared itself idle during it
+static uint64_t  passStartActive;
+static uint64_t  passCycles;
+static uint8_t   passIdle;
+static uint8_t   lastPassIdle;
+
+static uint64_t  passes;
+static uint64_t  skippedPasses;
+static uint64_t  activeCycles;        // CPU running (sleep = now - activeCycles)
+static uint64_t  groupCycles;         // library calls of the cars beyond car 0
+static uint64_t  wakeUps;
+static uint32_t  arrivals;
+static uint32_t  pressCount;
+static uint32_t  floorPasses;
+static uint32_t  doorOpenings;
+static struct timespec hostStart;
+
+// watchdog (avr/wdt.h)
+static uint64_t  watchdogCycles;      // timeout, 0 = off
+static uint64_t  watchdogKick;        // last wdt_reset()
+static uint8_t   watchdogSkipped;     // skipped passes would have reset it
+
+
+/*******************************************************************************
+***  PRIVATE FUNCTIONS  ********************************************************
+*******************************************************************************/
+// Convert a button name of the scenario file ("LiftButton_F<n>" or
+// "FloorButton_F<n>", optionally followed by "@<car>") to car * KEYS + key;
+// floor buttons belong to all cars
+static int32_t ParseButton (const char *name)
+{
+	unsigned int floor;
+	unsigned int car = 0;
+	int          length = 0;
+
+	if (sscanf(name, "LiftButton_F%u%n", &floor, &length) == 1)
+	{
+		if (name[length] == '@' && sscanf(name + length + 1, "%u", &car) != 1)
+		{
+			return -1;
+		}
+		if ((name[length] != '\0' && name[length] != '@') || floor >= FLOORS || car >= LIFT_CARS_MAX)
+		{
+			return -1;
+		}
+		return (int32_t)(car * KEYS + floor);
+	}
+	if (sscanf(name, "FloorButton_F%u%n", &floor, &length) == 1)
+	{
+		if ((name[length] != '\0' && name[length] != '@') || floor >= FLOORS)
+		{
+			return -1;
+		}
+		return (int32_t)(FLOORS + floor);
+	}
+	return -1;
+}
+
+// Convert a fault name of the scenario file ("DoorJam_F<n>" or "CabinJam",
+// optionally followed by "@<car>") to car * JAMS + door or cabin
+static int32_t ParseJam (const char *name)
+{
+	unsigned int what = FLOORS;
+	unsigned int car = 0;
+	int          length = 0;
+
+	if (sscanf(name, "DoorJam_F%u%n", &what, &length) != 1 || what >= FLOORS)
+	{
+		if (strncmp(name, "CabinJam", 8) != 0)
+		{
+			return -1;
+		}
+		what   = FLOORS;
+		length = 8;
+	}
+	if (name[length] == '@' && sscanf(name + length + 1, "%u", &car) != 1)
+	{
+		return -1;
+	}
+	if ((name[length] != '\0' && name[length] != '@') || car >= LIFT_CARS_MAX)
+	{
+		return -1;
+	}
+	return (int32_t)(car * JAMS + what);
+}
+
+// Name of a button for the event log
+static void PrintButton (uint32_t key)
+{
+	uint8_t car = key / KEYS;
+
+	key %= KEYS;
+	fprintf(stderr, "%s_F%u", (key < FLOORS) ? "LiftButton" : "FloorButton", key % FLOORS);
+	if (car > 0)
+	{
+		fprintf(stderr, "@%u", car);
+	}
+	fprintf(stderr, "\n");
+}
+
+static uint64_t EnvNumber (const char *name, uint64_t fallback)
+{
+	const char *value = getenv(name);
+	return (value && *value) ? strtoull(value, NULL, 10) : fallback;
+}
+
+// Insert an event into the queue
+static void Push (uint64_t at, SimEventKind kind, uint32_t arg)
+{
+	uint32_t child = queueCount++;
+
+	if (queueCount > queueCapacity)
+	{
+		queueCapacity = queueCapacity ? queueCapacity * 2 : 64;
+		queue = realloc(queue, queueCapacity * sizeof(SimEventType));
+	}
+
+	while (child > 0)
+	{
+		uint32_t parent = (child - 1) / 2;
+		if (queue[parent].at <= at)
+		{
+			break;
+		}
+		queue[child] = queue[parent];
+		child = parent;
+	}
+	queue[child].at   = at;
+	queue[child].kind = kind;
+	queue[child].arg  = arg;
+
+	nextEvent = queue[0].at;
+}
+
+// Remove the head of the queue
+static SimEventType Pop (void)
+{
+	SimEventType head = queue[0];
+	SimEventType last = queue[--queueCount];
+	uint32_t     parent = 0;
+
+	while (1)
+	{
+		uint32_t child = 2 * parent + 1;
+		if (child >= queueCount)
+		{
+			break;
+		}
+		if (child + 1 < queueCount && queue[child + 1].at < queue[child].at)
+		{
+			child++;
+		}
+		if (last.at <= queue[child].at)
+		{
+			break;
+		}
+		queue[parent] = queue[child];
+		parent = child;
+	}
+	if (queueCount > 0)
+	{
+		queue[parent] = last;
+	}
+
+	nextEvent = queueCount ? queue[0].at : NEVER;
+	return head;
+}
+
+// Read the scenario file into the event queue
+static void LoadScenario (const char *path)
+{
+	FILE     *file = fopen(path, "r");
+	char     line[128];
+	uint32_t lineNo = 0;
+
+	if (file == NULL)
+	{
+		fprintf(stderr, "liftsim: cannot open scenario '%s'\n", path);
+		exit(2);
+	}
+
+	while (fgets(line, sizeof(line), file))
+	{
+		char          name[32];
+		double        atMs;
+		unsigned long holdMs = holdUs / 1000;
+		int           fields;
+		int32_t       key;
+
+		lineNo++;
+		char *comment = strchr(line, '#');
+		if (comment)
+		{
+			*comment = '\0';
+		}
+
+		fields = sscanf(line, "%lf %31s %lu", &atMs, name, &holdMs);
+		if (fields <= 0)
+		{
+			continue;
+		}
+
+		uint64_t at = (uint64_t)(atMs * 1000.0) * CYCLES_PER_US;
+
+		key = (fields >= 2) ? ParseJam(name) : -1;
+		if (key >= 0)
+		{
+			Push(at, JamStart, (uint32_t)key);
+			Push(at + (uint64_t)holdMs * 1000 * CYCLES_PER_US, JamEnd, (uint32_t)key);
+			continue;
+		}
+
+		key = (fields >= 2) ? ParseButton(name) : -1;
+		if (key < 0)
+		{
+			fprintf(stderr, "liftsim: %s:%lu: unknown button\n", path, (unsigned long)lineNo);
+			exit(2);
+		}
+
+		Push(at, ButtonArrival, (uint32_t)key);
+		Push(at + (uint64_t)holdMs * 1000 * CYCLES_PER_US, ButtonRelease, (uint32_t)key);
+		pressCount++;
+	}
+	fclose(file);
+}
+
+// Handle all events that are due and rebuild PIND
+static void ProcessEvents (void)
+{
+	while (nextEvent <= now)
+	{
+		SimEventType event = Pop();
+		uint8_t      car = event.arg / KEYS;
+		uint8_t      key = event.arg % KEYS;
+
+		if (event.kind == ButtonArrival)
+		{
+			arrivals++;
+			pressDepth[car][key]++;
+			if (verbose)
+			{
+				fprintf(stderr, "%12.3f  press    ", LiftSimMicros() / 1e6);
+				PrintButton(event.arg);
+			}
+		}
+		else if (event.kind == ButtonRelease)
+		{
+			pressDepth[car][key]--;
+		}
+		else if (event.kind == JamStart || event.kind == JamEnd)
+		{
+			uint8_t on = (event.kind == JamStart);
+
+			LiftModelJam(event.arg / JAMS, event.arg % JAMS, on);
+			if (verbose)
+			{
+				fprintf(stderr, "%12.3f  %-8s %s", LiftSimMicros() / 1e6, on ? "jam" : "free",
+				        (event.arg % JAMS < FLOORS) ? "door" : "cabin");
+				if (event.arg % JAMS < FLOORS)
+				{
+					fprintf(stderr, " %u", event.arg % JAMS);
+				}
+				if (event.arg / JAMS > 0)
+				{
+					fprintf(stderr, "   car %u", event.arg / JAMS);
+				}
+				fprintf(stderr, "\n");
+			}
+		}
+		else if (event.kind == TrafficDue)
+		{
+			LiftTrafficEvent(event.arg);
+		}
+	}
+
+	for (uint8_t car = 0; car < LIFT_CARS_MAX; car++)
+	{
+		uint64_t cabin = 0;
+		uint64_t floor = 0;
+
+		for (uint8_t level = 0; level < FLOORS; level++)
+		{
+			if (pressDepth[car][level])
+			{
+				cabin |= (uint64_t)1 << level;
+			}
+			if (pressDepth[0][FLOORS + level])
+			{
+				floor |= (uint64_t)1 << level;
+			}
+		}
+		carCabinKeys[car] = cabin;
+		carFloorKeys[car] = floor;
+
+		// ButtonType layout: cabin buttons in the low nibble, floor buttons
+		// in the high nibble
+		uint8_t mask = (1 << PIND_FLOORS) - 1;
+		carPins[car] = (uint8_t)((cabin & mask) | ((floor & mask) << 4));
+	}
+	PIND = carPins[selectedCar];
+
+	// the controller may do something else now, idle time is measured anew
+	passIdle       = 0;
+	lastPassIdle   = 0;
+	repeatWakeUps  = 0;
+	repeatDeclared = 0;
+}
+
+// How many SetOutput() calls of a car may be skipped before one of its
+// doors finishes
+static uint64_t PassesUntilDoor (uint8_t car)
+{
+	uint64_t limit = NEVER;
+
+	for (uint8_t floor = 0; floor < FLOORS; floor++)
+	{
+		uint64_t deadline = doorDeadline[car][floor];
+
+		if (deadline > carPasses[car] && deadline - carPasses[car] - 1 < limit)
+		{
+			limit = deadline - carPasses[car] - 1;
+		}
+	}
+	return limit;
+}
+
+// Advance the model of a car by skipped SetOutput() calls
+static void SkipPasses (uint8_t car, uint64_t count)
+{
+	LiftModelSkipPasses(car, count);
+	carPasses[car] += count;
+	skippedPasses  += count;
+	watchdogSkipped = 1;
+}
+
+// A wake-up of the controller starts: its library calls are counted from here
+static void StartWakeUp (void)
+{
+	wakeStartActive = activeCycles;
+	wakeStartGroup  = groupCycles;
+	for (uint8_t car = 0; car < LIFT_CARS_MAX; car++)
+	{
+		wakeStartPasses[car] = carPasses[car];
+		wakeStartMoves[car]  = LiftModelMoveCalls(car);
+	}
+}
+
+// End the run like a watchdog reset once wdt_reset() is overdue
+static void CheckWatchdog (void)
+{
+	if (watchdogSkipped)
+	{
+		watchdogKick    = now;
+		watchdogSkipped = 0;
+	}
+	if (watchdogCycles && now - watchdogKick > watchdogCycles)
+	{
+		fprintf(stderr, "liftsim: %.3f s: watchdog reset, no wdt_reset() for %.1f ms\n",
+		        LiftSimMicros() / 1e6, (now - watchdogKick) / (F_CPU / 1000.0));
+		exit(3);
+	}
+}
+
+// Compare value (TOP) of a timer in CTC mode
+static uint32_t TimerTop (uint8_t index)
+{
+	return (index == 0) ? OCR0 : OCR1A;
+}
+
+// Compute the due time of the next compare match from the last one
+static void Reschedule (SimTimerType *timer)
+{
+	timer->due = timer->lastMatch + (uint64_t)(timer->top + 1) * prescalers[timer->clock];
+}
+
+// Pick up register changes of the controller and find the next compare
+// match of all timers
+static void RefreshTimers (void)
+{
+	timerDue = NEVER;
+
+	for (uint8_t index = 0; index < TIMERS; index++)
+	{
+		SimTimerType *timer = &timers[index];
+		uint8_t      clock = *timer->control & 0x07;
+		uint16_t     top = TimerTop(index);
+
+		if (clock != timer->clock || top != timer->top)
+		{
+			if (prescalers[clock] == 0)
+			{
+				timer->due = NEVER;
+			}
+			else
+			{
+				if (prescalers[timer->clock] == 0)
+				{
+					// the counter starts from zero when the clock is switched on
+					timer->lastMatch = now;
+				}
+				timer->top   = top;
+				timer->clock = clock;
+				Reschedule(timer);
+			}
+			timer->clock = clock;
+		}
+
+		if (timer->due < timerDue)
+		{
+			timerDue = timer->due;
+		}
+	}
+}
+
+// Run an interrupt routine the way the CPU does: with interrupts disabled
+static void Interrupt (uint8_t index)
+{
+	TIFR &= ~_BV(timers[index].interruptBit);
+	if (timers[index].vector)
+	{
+		interruptsOn = 0;
+		timers[index].vector();
+		interruptsOn = 1;
+		chargedCycles += ISR_CYCLES;
+	}
+}
+
+// Compare match of the timer that is due first: set its flag and run the
+// ISR if allowed
+static void Match (void)
+{
+	uint8_t      index = (timers[0].due <= timers[1].due) ? 0 : 1;
+	SimTimerType *timer = &timers[index];
+
+	timer->lastMatch = timer->due;
+	Reschedule(timer);
+	TIFR |= _BV(timer->interruptBit);
+	if (interruptsOn && (TIMSK & _BV(timer->interruptBit)))
+	{
+		Interrupt(index);
+	}
+
+	// register writes of the ISR are picked up by the next RefreshTimers()
+	timerDue = (timers[0].due < timers[1].due) ? timers[0].due : timers[1].due;
+}
+
+// Run pending interrupts once the I bit is set again
+static void ServicePending (void)
+{
+	if (!interruptsOn || !TIFR)
+	{
+		return;
+	}
+	for (uint8_t index = 0; index < TIMERS; index++)
+	{
+		uint8_t bit = _BV(timers[index].interruptBit);
+		if ((TIFR & bit) && (TIMSK & bit))
+		{
+			Interrupt(index);
+		}
+	}
+}
+
+// Earliest compare match that raises an interrupt, NEVER if none does
+static uint64_t NextWakeUp (void)
+{
+	uint64_t wake = NEVER;
+
+	for (uint8_t index = 0; index < TIMERS; index++)
+	{
+		if ((TIMSK & _BV(timers[index].interruptBit)) && timers[index].due < wake)
+		{
+			wake = timers[index].due;
+		}
+	}
+	return wake;
+}
+
+// Let the simulated time run up to target: scenario events and compare
+// matches are handled in time order, events first when they coincide
+static void AdvanceTo (uint64_t target)
+{
+	ServicePending();
+	RefreshTimers();
+
+	while (nextEvent <= target || timerDue <= target)
+	{
+		if (nextEvent <= timerDue)
+		{
+			now = (nextEvent > now) ? nextEvent : now;
+			ProcessEvents();
+		}
+		else
+		{
+			now = (timerDue > now) ? timerDue : now;
+			Match();
+		}
+	}
+	now = target;
+
+	// counter registers as seen by the controller, after the interrupt
+	// routines that ran at the end
+	if (timers[0].due != NEVER)
+	{
+		TCNT0 = (uint8_t)((now + chargedCycles - timers[0].lastMatch) / prescalers[timers[0].clock]);
+	}
+	if (timers[1].due != NEVER)
+	{
+		TCNT1 = (uint16_t)((now + chargedCycles - timers[1].lastMatch) / prescalers[timers[1].clock]);
+	}
+}
+
+// Move the clock on by the CPU time the controller used
+static void RunCharged (void)
+{
+	uint64_t cycles = chargedCycles;
+
+	// interrupts in between charge their cycles for the next call
+	activeCycles += cycles;
+	chargedCycles = 0;
+	AdvanceTo(now + cycles);
+	CheckWatchdog();
+
+	if (now >= endTime)
+	{
+		exit(0);
+	}
+}
+
+// Print the summary of the run
+static void Report (void)
+{
+	struct timespec hostEnd;
+	double          hostSeconds;
+	// the run can end in the middle of charged cycles (watchdog reset, end
+	// of the simulated time): the clock did not get there
+	uint64_t        active = (activeCycles < now) ? activeCycles : now;
+	double          duty = now ? (double)active / now : 1.0;
+
+	clock_gettime(CLOCK_MONOTONIC, &hostEnd);
+	hostSeconds = (hostEnd.tv_sec - hostStart.tv_sec) + (hostEnd.tv_nsec - hostStart.tv_nsec) / 1e9;
+
+	fprintf(stderr, "liftsim: %.3f s simulated in %llu loop passes (%llu passes skipped), "
+	        "%.3f s host time (%.1f M passes/s)\n",
+	        LiftSimMicros() / 1e6, (unsigned long long)passes, (unsigned long long)skippedPasses,
+	        hostSeconds, hostSeconds > 0 ? passes / hostSeconds / 1e6 : 0.0);
+	fprintf(stderr, "liftsim: %lu of %lu presses replayed, %lu floor passes, %lu door openings\n",
+	        (unsigned long)arrivals, (unsigned long)pressCount,
+	        (unsigned long)floorPasses, (unsigned long)doorOpenings);
+	fprintf(stderr, "liftsim: cpu active %.1f %% (%.3f s), asleep %.3f s, %llu wake-ups, "
+	        "~%.1f mA average (%.1f mA without sleep)\n",
+	        duty * 100.0, active / (F_CPU * 1.0), (now - active) / (F_CPU * 1.0),
+	        (unsigned long long)wakeUps, duty * ACTIVE_MA + (1.0 - duty) * IDLE_MA, ACTIVE_MA);
+	if (carsUsed > 1)
+	{
+		fprintf(stderr, "liftsim: library calls of cars 1..%u: %.3f s (%.1f %% on top of the cpu), "
+		        "not charged to the clock\n", carsUsed - 1, groupCycles / (F_CPU * 1.0),
+		        now ? groupCycles * 100.0 / now : 0.0);
+	}
+	LiftTrafficReport();
+	LiftEepromReport();
+}
+
+
+/*******************************************************************************
+***  PUBLIC FUNCTIONS  *********************************************************
+*******************************************************************************/
+// Load the configuration and the scenario
+void LiftSimInit (void)
+{
+	static uint8_t initialized = 0;
+	const char     *scenario = getenv("LIFTSIM_SCENARIO");
+	uint64_t       lastEvent = 0;
+	uint64_t       trafficEnd;
+
+	if (initialized)
+	{
+		return;
+	}
+	initialized = 1;
+
+	holdUs   = (uint32_t)EnvNumber("LIFTSIM_HOLD_MS", DEFAULT_HOLD_MS) * 1000;
+	verbose  = (uint8_t)EnvNumber("LIFTSIM_VERBOSE", 0);
+	skipIdle = (uint8_t)EnvNumber("LIFTSIM_SKIP", 1);
+
+	LiftEepromInit();
+	if (scenario && *scenario)
+	{
+		LoadScenario(scenario);
+	}
+	trafficEnd = LiftTrafficInit() * CYCLES_PER_US;
+	lastEvent  = trafficEnd;
+	for (uint32_t i = 0; i < queueCount; i++)
+	{
+		if (queue[i].at > lastEvent)
+		{
+			lastEvent = queue[i].at;
+		}
+	}
+
+	endTime = EnvNumber("LIFTSIM_TIME_S", lastEvent / F_CPU + DEFAULT_TAIL_S) * F_CPU;
+
+	clock_gettime(CLOCK_MONOTONIC, &hostStart);
+	atexit(Report);
+}
+
+// The lift model used CPU time; the calls for the cars beyond car 0 drive
+// shafts the board does not have and are counted apart from the clock
+void LiftSimCharge (uint16_t cycles)
+{
+	if (selectedCar == 0)
+	{
+		chargedCycles += cycles;
+	}
+	else
+	{
+		groupCycles += cycles;
+	}
+}
+
+// One pass of the superloop has finished
+void LiftSimPass (void)
+{
+	passes++;
+	carPasses[selectedCar]++;
+	RunCharged();
+
+	passCycles      = activeCycles - passStartActive;
+	passStartActive = activeCycles;
+	lastPassIdle    = passIdle;
+	passIdle        = 0;
+}
+
+// Let simulated time pass without a loop pass
+void LiftSimDelay (uint32_t us)
+{
+	chargedCycles += (uint64_t)us * CYCLES_PER_US;
+	RunCharged();
+}
+
+// The controller has nothing to do until the next event
+void LiftSimWaitForEvent (void)
+{
+	uint64_t target = (nextEvent < endTime) ? nextEvent : endTime;
+	uint64_t skip;
+
+	RefreshTimers();
+	if (!skipIdle)
+	{
+		return;
+	}
+	if (NextWakeUp() != NEVER)
+	{
+		// a controller with a timer interrupt sleeps (usually called right
+		// before sleep_cpu() with interrupts off): LiftSimSleep() fast-forwards
+		repeatDeclared = NEVER;
+		return;
+	}
+
+	// free running controller: the passes in between would not change
+	// anything, so only the pass-counted parts of the model are advanced;
+	// the last pass before the event still runs for real. The cost of a
+	// pass is only known once a whole idle pass has been measured.
+	passIdle = 1;
+	if (!lastPassIdle || target <= now + passCycles)
+	{
+		return;
+	}
+	skip = (target - now + passCycles - 1) / passCycles - 1;
+	for (uint8_t car = 0; car < carsUsed; car++)
+	{
+		if (skip > PassesUntilDoor(car))
+		{
+			skip = PassesUntilDoor(car);
+		}
+	}
+	SkipPasses(selectedCar, skip);
+	activeCycles    += skip * passCycles;
+	passStartActive += skip * passCycles;
+	AdvanceTo(now + skip * passCycles);
+}
+
+// The controller's next wake-ups do what the last one did
+void LiftSimRepeat (uint32_t wakeUps)
+{
+	if (skipIdle)
+	{
+		repeatDeclared = wakeUps;
+	}
+}
+
+// Closed form of the tick interrupt of the controller
+void LiftSimRepeatInterrupt (void (*repeat)(uint32_t matches))
+{
+	repeatInterrupt = repeat;
+}
+
+// sleep_cpu(): stop the CPU until an interrupt wakes it up
+void LiftSimSleep (void)
+{
+	uint64_t wake;
+	uint64_t wakeCycles;
+	uint64_t wakeGroup;
+	uint64_t declared = repeatDeclared;
+	uint8_t  alike;
+
+	if (!(MCUCR & _BV(SE)))
+	{
+		return;
+	}
+	RunCharged();
+
+	// what one wake-up cost, measured from the last one, and whether it
+	// did exactly what the wake-up before did
+	wakeCycles     = activeCycles - wakeStartActive;
+	wakeGroup      = groupCycles - wakeStartGroup;
+	alike          = (wakeCycles == lastWakeCycles && wakeGroup == lastWakeGroup);
+	for (uint8_t car = 0; car < carsUsed; car++)
+	{
+		uint64_t passesNow = carPasses[car] - wakeStartPasses[car];
+		uint64_t movesNow  = LiftModelMoveCalls(car) - wakeStartMoves[car];
+
+		alike           = alike && passesNow == wakePasses[car] && movesNow == wakeMoves[car];
+		wakePasses[car] = passesNow;
+		wakeMoves[car]  = movesNow;
+	}
+	lastWakeCycles = wakeCycles;
+	lastWakeGroup  = wakeGroup;
+	repeatWakeUps  = declared ? repeatWakeUps + 1 : 0;
+	repeatDeclared = 0;
+
+	// an interrupt that became pending before the SLEEP instruction wakes
+	// the CPU right away
+	for (uint8_t index = 0; index < TIMERS; index++)
+	{
+		uint8_t bit = _BV(timers[index].interruptBit);
+		if ((TIFR & bit) && (TIMSK & bit) && interruptsOn)
+		{
+			ServicePending();
+			wakeUps++;
+			StartWakeUp();
+			return;
+		}
+	}
+
+	RefreshTimers();
+	wake = interruptsOn ? NextWakeUp() : NEVER;
+	if (wake == NEVER)
+	{
+		fprintf(stderr, "liftsim: %.3f s: sleeping without a wake-up source\n", LiftSimMicros() / 1e6);
+		exit(1);
+	}
+
+	// The controller declared that the following wake-ups do the same, and
+	// the wake-up measured above was already such a one and cost what the
+	// one before did: they are replayed without the controller, up to the
+	// next event, the end of the declaration, a door that finishes or a
+	// cabin at its next position.
+	if (repeatWakeUps >= 2 && alike)
+	{
+		SimTimerType *timer = &timers[1];
+		uint64_t     period = (uint64_t)(timer->top + 1) * prescalers[timer->clock];
+		uint64_t     limit = (nextEvent < endTime) ? nextEvent : endTime;
+		uint64_t     count = 0;
+
+		// only the tick interrupt wakes the CPU, and it has a closed form
+		if (repeatInterrupt && wake == timer->due
+		    && (timers[0].due == NEVER || !(TIMSK & _BV(timers[0].interruptBit)))
+		    && wakeCycles < period && wake + wakeCycles < limit)
+		{
+			count = (limit - 1 - wakeCycles - wake) / period + 1;
+		}
+		if (count > declared)
+		{
+			count = declared;
+		}
+		for (uint8_t car = 0; car < carsUsed; car++)
+		{
+			if (wakePasses[car] > 0 && PassesUntilDoor(car) / wakePasses[car] < count)
+			{
+				count = PassesUntilDoor(car) / wakePasses[car];
+			}
+			if (wakeMoves[car] > 0 && LiftModelMovesLeft(car) / wakeMoves[car] < count)
+			{
+				count = LiftModelMovesLeft(car) / wakeMoves[car];
+			}
+		}
+		if (count > UINT32_MAX)
+		{
+			count = UINT32_MAX;
+		}
+
+		if (count > 0)
+		{
+			// the compare matches up to the last replayed wake-up, their
+			// interrupt routine in one go
+			timer->lastMatch = wake + (count - 1) * period;
+			Reschedule(timer);
+			timerDue = timer->due;
+			interruptsOn = 0;
+			repeatInterrupt((uint32_t)count);
+			interruptsOn = 1;
+
+			now            = timer->lastMatch + wakeCycles;
+			activeCycles  += count * wakeCycles;
+			groupCycles   += count * wakeGroup;
+			chargedCycles  = 0;  // the interrupt routines are part of wakeCycles
+			wakeUps       += count;
+			for (uint8_t car = 0; car < carsUsed; car++)
+			{
+				SkipPasses(car, count * wakePasses[car]);
+				LiftModelSkipMoves(car, count * wakeMoves[car]);
+			}
+			repeatWakeUps = 0;
+			AdvanceTo(now);
+			wake = NextWakeUp();
+		}
+	}
+
+	wakeUps++;
+	AdvanceTo(wake);
+	if (now >= endTime)
+	{
+		exit(0);
+	}
+	StartWakeUp();
+}
+
+// sei() / cli()
+void LiftSimInterrupts (uint8_t enable)
+{
+	interruptsOn = enable;
+}
+
+// Start or stop the watchdog
+void LiftSimWatchdog (uint8_t value)
+{
+	watchdogCycles = (value == LIFTSIM_WDT_OFF) ? 0 : ((uint64_t)WATCHDOG_BASE_US << (value & 7)) * CYCLES_PER_US;
+	watchdogKick   = now + chargedCycles;
+}
+
+// wdt_reset()
+void LiftSimWatchdogReset (void)
+{
+	watchdogKick = now + chargedCycles;
+}
+
+// Remember when a door will have finished moving
+void LiftSimScheduleDoor (uint8_t car, LiftPosType floor, uint32_t passesBefore)
+{
+	doorDeadline[car][floor] = carPasses[car] + passesBefore + 1;
+}
+
+// A passenger presses a button now, returns when it is released [us]
+uint64_t LiftSimPress (uint8_t car, LiftPosType floor, uint8_t cabin)
+{
+	uint32_t key = car * KEYS + (cabin ? 0 : FLOORS) + floor;
+
+	Push(now, ButtonArrival, key);
+	Push(now + (uint64_t)holdUs * CYCLES_PER_US, ButtonRelease, key);
+	pressCount++;
+	return LiftSimMicros() + holdUs;
+}
+
+// Call LiftTrafficEvent(arg) at a simulated time [us]
+void LiftSimScheduleTraffic (uint64_t us, uint32_t arg)
+{
+	Push(us * CYCLES_PER_US, TrafficDue, arg);
+}
+
+// The controller takes an input at a simulated time [us] that the model
+// does not know about: idle wake-ups are not skipped past it
+void LiftSimScheduleWakeUp (uint64_t us)
+{
+	Push(us * CYCLES_PER_US, WakeUp, 0);
+}
+
+// The library selected a car
+void LiftSimSelectCar (uint8_t car)
+{
+	selectedCar = car;
+	if (car >= carsUsed)
+	{
+		carsUsed = car + 1;
+	}
+	PIND = carPins[car];
+}
+
+// Buttons of a car, one bit per floor
+void LiftSimButtons (uint8_t car, uint64_t *cabin, uint64_t *floor)
+{
+	*cabin = carCabinKeys[car];
+	*floor = carFloorKeys[car];
+}
+
+// Current simulated time in microseconds
+uint64_t LiftSimMicros (void)
+{
+	return now / CYCLES_PER_US;
+}
+
+// CPU cycles so far, including those charged since the clock last moved
+uint64_t LiftSimCycles (void)
+{
+	return now + chargedCycles;
+}
+
+// The cabin reached (or passed) a floor
+void LiftSimNoteFloor (uint8_t car, LiftPosType floor)
+{
+	floorPasses++;
+	if (verbose && carsUsed > 1)
+	{
+		fprintf(stderr, "%12.3f  floor    %d        car %d\n", LiftSimMicros() / 1e6, floor, car);
+	}
+	else if (verbose)
+	{
+		fprintf(stderr, "%12.3f  floor    %d\n", LiftSimMicros() / 1e6, floor);
+	}
+}
+
+// A door finished opening or closing
+void LiftSimNoteDoor (uint8_t car, LiftPosType floor, DoorStateType state)
+{
+	doorDeadline[car][floor] = 0;
+	if (state == Open)
+	{
+		doorOpenings++;
+	}
+	LiftTrafficDoor(car, floor, state);
+	if (verbose && carsUsed > 1)
+	{
+		fprintf(stderr, "%12.3f  door %d   %-6s car %d\n", LiftSimMicros() / 1e6, floor, state == Open ? "open" : "closed", car);
+	}
+	else if (verbose)
+	{
+		fprintf(stderr, "%12.3f  door %d   %s\n", LiftSimMicros() / 1e6, floor, state == Open ? "open" : "closed");
+	}
+}
+
+// A call indicator was switched on or off
+void LiftSimNoteIndicator (uint8_t car, LiftPosType floor, uint8_t cabin, uint8_t on)
+{
+	LiftTrafficIndicator(car, floor, cabin, on);
+}
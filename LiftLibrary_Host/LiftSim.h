@@ -0,0 +1,170 @@
+/******************************************************************************
+* Program:   Lift simulation library (host stand-in)
+* Filename:  LiftSim.h
+* Version:   1.11
+* Date:      16.10.2026
+*
+* Description:
+* Runtime of the host simulation: simulated clock, button scenario that
+* drives PIND, end-of-run handling and statistics. The lift model in
+* library.c calls into here; the controller (main.c) does not need to know
+* about it.
+*
+* Configuration (environment variables):
+* - LIFTSIM_SCENARIO  button script, one "<time_ms> <ButtonType> [hold_ms]"
+*                     per line, '#' starts a comment; "<ButtonType>@<car>"
+*                     presses a cabin button of another car (LiftGroup.h).
+*                     The names follow the floor count of the shaft
+*                     (LiftButton_F0 .. and FloorButton_F0 ..).
+*                     Faults of the model are scripted the same way, the
+*                     hold time is how long they last: "DoorJam_F<n>"
+*                     stops the door of a floor where it is, "CabinJam"
+*                     stops the cabin (both with an optional "@<car>").
+* - LIFTSIM_TIME_S    simulated run time (default: last press + 60 s)
+* - LIFTSIM_HOLD_MS   default press duration (default 200 ms)
+* - LIFTSIM_VERBOSE   1 = log button, floor and door events to stderr
+* - LIFTSIM_SKIP      0 = run every idle pass instead of jumping to the
+*                     next event (default 1)
+* - LIFTSIM_TRAFFIC   passenger traffic instead of or on top of the
+*                     scenario, see LiftTraffic.h
+* - LIFTSIM_EEPROM    file that keeps the EEPROM from run to run, see
+*                     LiftEeprom.h
+* - LIFTSIM_SHAFT     file that keeps the cabin positions and doors from
+*                     run to run (library.c)
+*
+* Clock:
+* Time is counted in CPU cycles at F_CPU. Every library call charges its
+* approximate cycle count (library.c), every ISR a fixed entry/exit cost;
+* the controller's own code is not charged. The summary shows the share of
+* cycles the CPU was awake (duty cycle). The calls for the cars beyond
+* car 0 of a group drive shafts the board does not have: their cycles are
+* summed up apart and do not delay the clock, so every car gets the same
+* library calls per control tick as a single car.
+*
+* Timers and sleep mode:
+* Timer0 and Timer1 run in CTC mode; a compare match calls TIMER0_COMP_vect
+* / TIMER1_COMPA_vect when the controller defines them (avr/interrupt.h).
+* sleep_cpu() stops the simulated CPU until the next enabled compare match.
+*
+* Skipping idle time:
+* Button arrivals and releases of the scenario and the passenger events
+* of the traffic are kept in a time ordered queue. The model reports how
+* many SetOutput() calls a moving door still needs and how many
+* MoveElevator() calls a cabin still needs to its next position, from its
+* position, the speed of the last call and the pacing counter. When the
+* controller calls LiftSimWaitForEvent() nothing changes for it until the
+* next event; with LiftSimRepeat() it only does the same for a number of
+* wake-ups (its own timers run out, see the controller):
+* - a free running controller (no timer interrupt): the passes up to the
+*   event are skipped, costed like the last pass
+* - a sleeping controller: once a whole wake-up was declared alike, the
+*   following wake-ups are replayed without the controller, up to the
+*   next event, the end of its declaration, a door that finishes or a
+*   cabin that reaches its next position (a floor included). The model of
+*   every car advances by the SetOutput() and MoveElevator() calls the car
+*   made in the measured wake-up, and the interrupt routine of the tick
+*   timer runs once for all compare matches in its closed form
+*   (LiftSimRepeatInterrupt()). The controller catches its tick counters
+*   up when it runs again.
+* A replay starts only after two declared wake-ups in a row with the same
+* cycles and library calls per car, so a change the controller made in a
+* wake-up (a door command that only shows in the next output refresh)
+* never gets replayed as the measured one.
+*
+*******************************************************************************/
+#ifndef LIFTSIM_H_
+#define LIFTSIM_H_
+
+/*** INCLUDE FILES ************************************************************/
+#include <stdint.h>
+#include "LiftLibrary.h"
+
+#ifndef F_CPU
+#define F_CPU 8000000UL
+#endif
+
+
+/*** PUBLIC FUNCTIONS *********************************************************/
+// Load the configuration and the scenario (called by InitializePorts)
+void LiftSimInit (void);
+
+// The lift model spent this many CPU cycles
+void LiftSimCharge (uint16_t cycles);
+
+// One pass of the superloop has finished (called by SetOutput)
+void LiftSimPass (void);
+
+// Let simulated time pass without a loop pass (util/delay.h)
+void LiftSimDelay (uint32_t us);
+
+// The controller has nothing to do until the next event (see above)
+void LiftSimWaitForEvent (void);
+
+// The controller's next wake-ups do what the last one did, for up to this
+// many wake-ups (see above)
+void LiftSimRepeat (uint32_t wakeUps);
+
+// Closed form of the controller's TIMER1_COMPA_vect: repeat(matches) does
+// what this many compare matches in a row do while no button changes
+void LiftSimRepeatInterrupt (void (*repeat)(uint32_t matches));
+
+// sleep_cpu(): sleep until the next enabled timer interrupt
+void LiftSimSleep (void);
+
+// sei() / cli()
+void LiftSimInterrupts (uint8_t enable);
+
+// Current simulated time in microseconds
+uint64_t LiftSimMicros (void);
+
+// CPU cycles so far, exact up to the last library call (profiling)
+uint64_t LiftSimCycles (void);
+
+// A door of a car finishes after passesBefore more SetOutput() calls of
+// that car
+void LiftSimScheduleDoor (uint8_t car, LiftPosType floor, uint32_t passesBefore);
+
+// Notifications from the lift model for the event log and statistics
+void LiftSimNoteFloor (uint8_t car, LiftPosType floor);
+void LiftSimNoteDoor (uint8_t car, LiftPosType floor, DoorStateType state);
+void LiftSimNoteIndicator (uint8_t car, LiftPosType floor, uint8_t cabin, uint8_t on);
+
+// Passenger traffic (LiftTraffic.c): press a button of a car now for the
+// hold time, returns when it is released [us]
+uint64_t LiftSimPress (uint8_t car, LiftPosType floor, uint8_t cabin);
+
+// Call LiftTrafficEvent(arg) at a simulated time [us]
+void LiftSimScheduleTraffic (uint64_t us, uint32_t arg);
+
+// The controller takes an input at a simulated time [us] that the model
+// does not know about (replayed buttons): idle wake-ups are not skipped
+// past it
+void LiftSimScheduleWakeUp (uint64_t us);
+
+// The library selected a car: PIND shows its buttons from now on
+void LiftSimSelectCar (uint8_t car);
+
+// Buttons of a car, one bit per floor
+void LiftSimButtons (uint8_t car, uint64_t *cabin, uint64_t *floor);
+
+// avr/wdt.h: start the watchdog with a WDTO_* timeout or stop it, reset it
+#define LIFTSIM_WDT_OFF     0xFF
+void LiftSimWatchdog (uint8_t value);
+void LiftSimWatchdogReset (void);
+
+// Implemented by the lift model (library.c): advance everything of a car
+// that is counted in loop passes as if SetOutput() had been called this often
+void LiftModelSkipPasses (uint8_t car, uint64_t count);
+
+// Implemented by the lift model: MoveElevator() calls of a car so far, the
+// calls like the last one that stay short of the next position (UINT64_MAX
+// if they do not move the cabin), and counting such calls without making them
+uint64_t LiftModelMoveCalls (uint8_t car);
+uint64_t LiftModelMovesLeft (uint8_t car);
+void LiftModelSkipMoves (uint8_t car, uint64_t count);
+
+// Implemented by the lift model: jam the door of a floor (what < floors) or
+// the cabin (what = floors) of a car, or free it again
+void LiftModelJam (uint8_t car, uint8_t what, uint8_t on);
+
+#endif /* LIFTSIM_H_ */
@@ -0,0 +1,515 @@
+/******************************************************************************
+* Program:   Lift simulation library (host stand-in)
+* Filename:  LiftTraffic.c
+* Version:   1.0
+* Date:      16.10.2026
+*
+* Description:
+* Passenger traffic and its statistics, see LiftTraffic.h for the model and
+* the configuration variables.
+*
+* Precondition:  LiftTrafficInit() is called by LiftSimInit()
+*
+* Postcondition: -
+*
+* Required Libraries:
+* - LiftSim.h
+* - LiftGroup.h
+* - libm
+*
+*******************************************************************************/
+
+/*** INCLUDE FILES ************************************************************/
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "LiftTraffic.h"
+#include "LiftSim.h"
+#include "LiftGroup.h"
+
+
+/*** OWN DEFINES **************************************************************/
+#define FLOORS              LIFT_FLOORS
+#define FLOOR_BIT(floor)    ((uint64_t)1 << (floor))
+#define NOT_YET             UINT64_MAX
+
+// traffic event: kind in the top bits, then cabin, car and floor
+#define EVENT_SHIFT         30
+#define EVENT(kind, car, floor, cabin) \
+	(((uint32_t)(kind) << EVENT_SHIFT) | ((uint32_t)(cabin) << 16) | ((uint32_t)(car) << 8) | (floor))
+
+
+/*** OWN DATA TYPES ***********************************************************/
+typedef enum {Uppeak = 0, Downpeak, Lunch, Interfloor}
+PatternType;
+
+typedef enum {PassengerArrives = 0, PressEnds, PressAgain}
+TrafficEventKind;
+
+typedef enum {Waiting = 0, Riding, Delivered}
+PassengerStateType;
+
+typedef struct
+{
+	uint64_t            arrived;    // [us]
+	uint64_t            boarded;
+	uint64_t            left;
+	LiftPosType         origin;
+	LiftPosType         destination;
+	uint8_t             car;
+	PassengerStateType  state;
+} PassengerType;
+
+typedef struct
+{
+	uint32_t  count;
+	double    mean;
+	double    p50;
+	double    p95;
+	double    p99;
+	double    max;
+} PercentilesType;
+
+
+/*** GLOBAL Variablen *********************************************************/
+static const char *patternNames[] = {"uppeak", "downpeak", "lunch", "interfloor"};
+
+static uint8_t        enabled;
+static uint8_t        verbose;
+static PatternType    pattern;
+static uint32_t       rate;              // passengers per hour
+static uint64_t       seed;
+static uint64_t       randomState;
+static uint64_t       arrivalsEnd;       // [us]
+
+static PassengerType  *passengers;
+static uint32_t       passengerCount;
+static uint32_t       passengerCapacity;
+static uint32_t       firstActive;       // passengers before it are delivered
+
+// doors that are open, call indicators that are on and buttons that are
+// held by a passenger right now, one bit per floor
+static uint64_t       doorsOpen[LIFT_CARS_MAX];
+static uint64_t       cabinLit[LIFT_CARS_MAX];
+static uint64_t       hallLit[LIFT_CARS_MAX];
+static uint64_t       cabinHeld[LIFT_CARS_MAX];
+static uint64_t       hallHeld;
+
+static uint32_t       delivered;
+static uint32_t       droppedCalls;
+static uint32_t       stops;
+
+
+/*******************************************************************************
+***  PRIVATE FUNCTIONS  ********************************************************
+*******************************************************************************/
+// xorshift64*: the same seed gives the same passengers on every host
+static double Uniform (void)
+{
+	randomState ^= randomState >> 12;
+	randomState ^= randomState << 25;
+	randomState ^= randomState >> 27;
+
+	// (0, 1]
+	return (double)(((randomState * 2685821657736338717ULL) >> 11) + 1) / 9007199254740992.0;
+}
+
+// One of count floors from Floor0 up
+static LiftPosType AnyFloor (uint8_t count)
+{
+	uint8_t floor = (uint8_t)(Uniform() * count);
+
+	return (LiftPosType)((floor < count) ? floor : count - 1);
+}
+
+// Any floor but one
+static LiftPosType OtherFloor (LiftPosType except)
+{
+	LiftPosType floor = AnyFloor(FLOORS - 1);
+
+	return (floor >= except) ? (LiftPosType)(floor + 1) : floor;
+}
+
+// Origin and destination of a new passenger
+static void PickTrip (PassengerType *passenger)
+{
+	double draw = Uniform() * 100.0;
+	double up = 0.0;
+	double down = 0.0;
+
+	switch (pattern)
+	{
+		case Uppeak:   up = TRAFFIC_LOBBY_PCT; break;
+		case Downpeak: down = TRAFFIC_LOBBY_PCT; break;
+		case Lunch:    up = TRAFFIC_LOBBY_PCT / 2.0; down = TRAFFIC_LOBBY_PCT / 2.0; break;
+		default:       break;
+	}
+
+	if (draw < up)
+	{
+		passenger->origin      = Floor0;
+		passenger->destination = OtherFloor(Floor0);
+	}
+	else if (draw < up + down)
+	{
+		passenger->origin      = OtherFloor(Floor0);
+		passenger->destination = Floor0;
+	}
+	else
+	{
+		passenger->origin      = AnyFloor(FLOORS);
+		passenger->destination = OtherFloor(passenger->origin);
+	}
+}
+
+// Some car shows the hall call of a floor
+static uint8_t HallLit (LiftPosType floor)
+{
+	for (uint8_t car = 0; car < LIFT_CARS_MAX; car++)
+	{
+		if (hallLit[car] & FLOOR_BIT(floor))
+		{
+			return 1;
+		}
+	}
+	return 0;
+}
+
+// Someone still needs the button: waits at the floor or rides the car there
+static uint8_t CallNeeded (uint8_t car, LiftPosType floor, uint8_t cabin)
+{
+	for (uint32_t index = firstActive; index < passengerCount; index++)
+	{
+		PassengerType *passenger = &passengers[index];
+
+		if (cabin ? (passenger->state == Riding && passenger->car == car && passenger->destination == floor)
+		          : (passenger->state == Waiting && passenger->origin == floor))
+		{
+			return 1;
+		}
+	}
+	return 0;
+}
+
+// Press a button unless the call is already shown or the button is held
+static void Press (uint8_t car, LiftPosType floor, uint8_t cabin)
+{
+	uint64_t *held = cabin ? &cabinHeld[car] : &hallHeld;
+	uint8_t  lit = cabin ? (cabinLit[car] & FLOOR_BIT(floor)) != 0 : HallLit(floor);
+	uint64_t released;
+
+	if (lit || (*held & FLOOR_BIT(floor)))
+	{
+		return;
+	}
+	*held |= FLOOR_BIT(floor);
+	released = LiftSimPress(cabin ? car : 0, floor, cabin);
+	LiftSimScheduleTraffic(released + TRAFFIC_ACK_MS * 1000ULL, EVENT(PressEnds, car, floor, cabin));
+}
+
+// The passenger gets into a car
+static void Board (PassengerType *passenger, uint8_t car)
+{
+	passenger->state   = Riding;
+	passenger->car     = car;
+	passenger->boarded = LiftSimMicros();
+	Press(car, passenger->destination, 1);
+}
+
+// A new passenger arrives, the next one is scheduled
+static void Arrive (void)
+{
+	PassengerType *passenger;
+	uint64_t      now = LiftSimMicros();
+	uint64_t      next;
+
+	if (passengerCount == passengerCapacity)
+	{
+		passengerCapacity = passengerCapacity ? passengerCapacity * 2 : 256;
+		passengers = realloc(passengers, passengerCapacity * sizeof(PassengerType));
+	}
+	passenger = &passengers[passengerCount++];
+	memset(passenger, 0, sizeof(PassengerType));
+	passenger->arrived = now;
+	passenger->boarded = NOT_YET;
+	passenger->left    = NOT_YET;
+	PickTrip(passenger);
+
+	if (verbose)
+	{
+		fprintf(stderr, "%12.3f  arrive   %d -> %d\n", now / 1e6, passenger->origin, passenger->destination);
+	}
+
+	// a car waits with open doors: get in right away
+	for (uint8_t car = 0; car < LIFT_CARS_MAX; car++)
+	{
+		if (doorsOpen[car] & FLOOR_BIT(passenger->origin))
+		{
+			Board(passenger, car);
+			break;
+		}
+	}
+	if (passenger->state == Waiting)
+	{
+		Press(0, passenger->origin, 0);
+	}
+
+	// Poisson arrivals: exponential time to the next passenger
+	next = now + (uint64_t)(-log(Uniform()) * 3600e6 / rate);
+	if (next < arrivalsEnd)
+	{
+		LiftSimScheduleTraffic(next, EVENT(PassengerArrives, 0, 0, 0));
+	}
+}
+
+static int CompareTimes (const void *a, const void *b)
+{
+	double first = *(const double *)a;
+	double second = *(const double *)b;
+
+	return (first > second) - (first < second);
+}
+
+// Nearest-rank percentiles of a sample, sorts the sample
+static PercentilesType Percentiles (double *values, uint32_t count)
+{
+	PercentilesType result = { 0 };
+
+	if (count == 0)
+	{
+		return result;
+	}
+	qsort(values, count, sizeof(double), CompareTimes);
+	for (uint32_t index = 0; index < count; index++)
+	{
+		result.mean += values[index] / count;
+	}
+	result.count = count;
+	result.p50   = values[(uint32_t)ceil(0.50 * count) - 1];
+	result.p95   = values[(uint32_t)ceil(0.95 * count) - 1];
+	result.p99   = values[(uint32_t)ceil(0.99 * count) - 1];
+	result.max   = values[count - 1];
+	return result;
+}
+
+static void PrintPercentiles (const char *name, PercentilesType times)
+{
+	fprintf(stderr, "traffic: %-8s P50 %6.1f s  P95 %6.1f s  P99 %6.1f s  (mean %.1f s, max %.1f s, %lu passengers)\n",
+	        name, times.p50, times.p95, times.p99, times.mean, times.max, (unsigned long)times.count);
+}
+
+
+/*******************************************************************************
+***  PUBLIC FUNCTIONS  *********************************************************
+*******************************************************************************/
+// Read the configuration and schedule the first passenger
+uint64_t LiftTrafficInit (void)
+{
+	const char *name = getenv("LIFTSIM_TRAFFIC");
+	const char *value;
+
+	if (name == NULL || *name == '\0')
+	{
+		return 0;
+	}
+	for (pattern = Uppeak; pattern <= Interfloor; pattern++)
+	{
+		if (strcmp(name, patternNames[pattern]) == 0)
+		{
+			break;
+		}
+	}
+	if (pattern > Interfloor)
+	{
+		fprintf(stderr, "liftsim: unknown traffic pattern '%s'\n", name);
+		exit(2);
+	}
+
+	value       = getenv("LIFTSIM_RATE");
+	rate        = (value && *value) ? (uint32_t)strtoul(value, NULL, 10) : TRAFFIC_RATE;
+	value       = getenv("LIFTSIM_SEED");
+	seed        = (value && *value) ? strtoull(value, NULL, 10) : 1;
+	value       = getenv("LIFTSIM_TRAFFIC_S");
+	arrivalsEnd = ((value && *value) ? strtoull(value, NULL, 10) : TRAFFIC_TIME_S) * 1000000ULL;
+	value       = getenv("LIFTSIM_VERBOSE");
+	verbose     = (value && *value) ? (uint8_t)strtoul(value, NULL, 10) : 0;
+
+	if (rate == 0)
+	{
+		fprintf(stderr, "liftsim: LIFTSIM_RATE must be at least 1\n");
+		exit(2);
+	}
+
+	// xorshift must not start at zero
+	randomState = seed * 0x9E3779B97F4A7C15ULL + 1;
+	enabled     = 1;
+
+	LiftSimScheduleTraffic((uint64_t)(-log(Uniform()) * 3600e6 / rate), EVENT(PassengerArrives, 0, 0, 0));
+	return arrivalsEnd;
+}
+
+// A traffic event is due
+void LiftTrafficEvent (uint32_t arg)
+{
+	TrafficEventKind kind = (TrafficEventKind)(arg >> EVENT_SHIFT);
+	uint8_t          cabin = (arg >> 16) & 0x01;
+	uint8_t          car = (arg >> 8) & 0xFF;
+	LiftPosType      floor = (LiftPosType)(arg & 0xFF);
+	uint8_t          lit;
+
+	switch (kind)
+	{
+		case PassengerArrives:
+		{
+			Arrive();
+			break;
+		}
+		case PressEnds:
+		case PressAgain:
+		{
+			if (kind == PressEnds)
+			{
+				if (cabin)
+				{
+					cabinHeld[car] &= ~FLOOR_BIT(floor);
+				}
+				else
+				{
+					hallHeld &= ~FLOOR_BIT(floor);
+				}
+			}
+
+			// the controller did not take the call: press again a bit later
+			lit = cabin ? (cabinLit[car] & FLOOR_BIT(floor)) != 0 : HallLit(floor);
+			if (lit || !CallNeeded(car, floor, cabin))
+			{
+				break;
+			}
+			if (kind == PressAgain)
+			{
+				Press(car, floor, cabin);
+				break;
+			}
+			droppedCalls++;
+			if (verbose)
+			{
+				fprintf(stderr, "%12.3f  dropped  %s_F%d\n", LiftSimMicros() / 1e6, cabin ? "LiftButton" : "FloorButton", floor);
+			}
+			LiftSimScheduleTraffic(LiftSimMicros() + TRAFFIC_RETRY_MS * 1000ULL, EVENT(PressAgain, car, floor, cabin));
+			break;
+		}
+	}
+}
+
+// A door of a car finished opening or closing: passengers get out and in
+void LiftTrafficDoor (uint8_t car, LiftPosType floor, DoorStateType state)
+{
+	if (!enabled || floor >= FLOORS)
+	{
+		return;
+	}
+	if (state != Open)
+	{
+		doorsOpen[car] &= ~FLOOR_BIT(floor);
+		return;
+	}
+	doorsOpen[car] |= FLOOR_BIT(floor);
+	stops++;
+
+	for (uint32_t index = firstActive; index < passengerCount; index++)
+	{
+		PassengerType *passenger = &passengers[index];
+
+		if (passenger->state == Riding && passenger->car == car && passenger->destination == floor)
+		{
+			passenger->state = Delivered;
+			passenger->left  = LiftSimMicros();
+			delivered++;
+		}
+	}
+	for (uint32_t index = firstActive; index < passengerCount; index++)
+	{
+		PassengerType *passenger = &passengers[index];
+
+		if (passenger->state == Waiting && passenger->origin == floor)
+		{
+			Board(passenger, car);
+		}
+	}
+	while (firstActive < passengerCount && passengers[firstActive].state == Delivered)
+	{
+		firstActive++;
+	}
+}
+
+// A call indicator of a car was switched
+void LiftTrafficIndicator (uint8_t car, LiftPosType floor, uint8_t cabin, uint8_t on)
+{
+	uint64_t *lit = cabin ? &cabinLit[car] : &hallLit[car];
+
+	if (floor >= FLOORS)
+	{
+		return;
+	}
+	*lit = on ? (*lit | FLOOR_BIT(floor)) : (*lit & ~FLOOR_BIT(floor));
+}
+
+// Print the statistics of the passengers
+void LiftTrafficReport (void)
+{
+	double   *waits;
+	double   *travels;
+	double   *journeys;
+	uint32_t boardedCount = 0;
+	uint32_t riding = 0;
+	double   hours = LiftSimMicros() / 3600e6;
+
+	if (!enabled)
+	{
+		return;
+	}
+
+	waits    = malloc((passengerCount + 1) * sizeof(double));
+	travels  = malloc((passengerCount + 1) * sizeof(double));
+	journeys = malloc((passengerCount + 1) * sizeof(double));
+	for (uint32_t index = 0; index < passengerCount; index++)
+	{
+		PassengerType *passenger = &passengers[index];
+
+		if (passenger->state != Waiting)
+		{
+			waits[boardedCount++] = (passenger->boarded - passenger->arrived) / 1e6;
+		}
+		if (passenger->state == Riding)
+		{
+			riding++;
+		}
+	}
+	for (uint32_t index = 0, count = 0; index < passengerCount; index++)
+	{
+		PassengerType *passenger = &passengers[index];
+
+		if (passenger->state == Delivered)
+		{
+			travels[count]  = (passenger->left - passenger->boarded) / 1e6;
+			journeys[count] = (passenger->left - passenger->arrived) / 1e6;
+			count++;
+		}
+	}
+
+	fprintf(stderr, "traffic: %s, %lu passengers/h for %llu s, seed %llu\n", patternNames[pattern],
+	        (unsigned long)rate, (unsigned long long)(arrivalsEnd / 1000000), (unsigned long long)seed);
+	fprintf(stderr, "traffic: %lu passengers, %lu delivered, %lu riding, %lu waiting, %lu dropped calls\n",
+	        (unsigned long)passengerCount, (unsigned long)delivered, (unsigned long)riding,
+	        (unsigned long)(passengerCount - boardedCount), (unsigned long)droppedCalls);
+	PrintPercentiles("wait", Percentiles(waits, boardedCount));
+	PrintPercentiles("travel", Percentiles(travels, delivered));
+	PrintPercentiles("journey", Percentiles(journeys, delivered));
+	fprintf(stderr, "traffic: %.1f trips/h, %.1f stops/h\n",
+	        hours > 0 ? delivered / hours : 0.0, hours > 0 ? stops / hours : 0.0);
+
+	free(waits);
+	free(travels);
+	free(journeys);
+}
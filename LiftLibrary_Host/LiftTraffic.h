@@ -0,0 +1,70 @@
+/******************************************************************************
+* Program:   Lift simulation library (host stand-in)
+* Filename:  LiftTraffic.h
+* Version:   1.0
+* Date:      16.10.2026
+*
+* Description:
+* Passenger traffic of the host simulation, for benchmarking a controller.
+* Passengers arrive at random (Poisson arrivals), press the floor button of
+* their floor, board the first car that opens its door there, press the
+* cabin button of their destination and leave the car when it opens the
+* door at the destination. Cars have no load limit, and a passenger boards
+* regardless of the direction the car goes next.
+*
+* Configuration (environment variables, see also LiftSim.h):
+* - LIFTSIM_TRAFFIC    traffic pattern, off by default:
+*                      uppeak      90 % from the lobby (Floor0) upwards
+*                      downpeak    90 % down to the lobby
+*                      lunch       45 % up from and 45 % down to the lobby
+*                      interfloor  between any two floors
+*                      the rest of uppeak, downpeak and lunch is interfloor
+* - LIFTSIM_RATE       passengers per hour (default 120)
+* - LIFTSIM_TRAFFIC_S  time passengers arrive in (default 3600 s); the run
+*                      goes on for LIFTSIM_TIME_S (default 60 s longer)
+* - LIFTSIM_SEED       seed of the random numbers (default 1), the same
+*                      seed gives the same passengers
+*
+* A press the controller does not acknowledge within TRAFFIC_ACK_MS after
+* the button is released, by the call indicator or by opening the door,
+* counts as a dropped call (e.g. a full call buffer in AddRequestToBuffer());
+* the passenger presses again after TRAFFIC_RETRY_MS.
+*
+* At the end of the run the summary lists the wait time (arrival to
+* boarding), travel time (boarding to leaving) and journey time as
+* P50/P95/P99, the delivered passengers and stops per hour and the dropped
+* calls.
+*
+*******************************************************************************/
+#ifndef LIFTTRAFFIC_H_
+#define LIFTTRAFFIC_H_
+
+/*** INCLUDE FILES ************************************************************/
+#include <stdint.h>
+#include "LiftLibrary.h"
+
+
+/*** OWN DEFINES **************************************************************/
+#define TRAFFIC_RATE        120     // default passengers per hour
+#define TRAFFIC_TIME_S      3600    // default time passengers arrive in
+#define TRAFFIC_ACK_MS      1000    // the controller reacts to a press
+#define TRAFFIC_RETRY_MS    5000    // a dropped call is pressed again
+#define TRAFFIC_LOBBY_PCT   90      // uppeak / downpeak share of the lobby
+
+
+/*** PUBLIC FUNCTIONS *********************************************************/
+// Read the configuration and schedule the first passenger (LiftSimInit),
+// returns the end of the arrivals in microseconds, 0 = no traffic
+uint64_t LiftTrafficInit (void);
+
+// A traffic event scheduled with LiftSimScheduleTraffic() is due
+void LiftTrafficEvent (uint32_t arg);
+
+// Notifications from the lift model
+void LiftTrafficDoor (uint8_t car, LiftPosType floor, DoorStateType state);
+void LiftTrafficIndicator (uint8_t car, LiftPosType floor, uint8_t cabin, uint8_t on);
+
+// Print the statistics of the passengers to stderr
+void LiftTrafficReport (void);
+
+#endif /* LIFTTRAFFIC_H_ */
@@ -0,0 +1,242 @@
+/******************************************************************************
+* Program:   Lift simulation library (host stand-in)
+* Filename:  LssCycles.c
+* Version:   1.0
+* Date:      16.10.2026
+*
+* Description:
+* Static cycle count of an AVR build from its extended listing (.lss, as
+* written by Atmel Studio next to the .elf). For every function the code
+* size, the instructions, the calls and the cycles of one pass through all
+* of its instructions are listed (ATmega32 instruction timing, branches
+* and skips not taken). Loops and branches are not followed, the count
+* compares the code of two build configurations, not their run time: a
+* function that was inlined disappears, its caller grows and loses the
+* cycles of the call and return.
+*
+*   LssCycles <lss> [<reference lss>]   functions of both, with the difference
+*
+*******************************************************************************/
+
+/*** INCLUDE FILES ************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+
+/*** OWN DEFINES **************************************************************/
+#define FUNCTIONS_MAX       512
+#define NAME_MAX            80
+#define LINE_MAX            512
+
+
+/*** OWN DATA TYPES ***********************************************************/
+typedef struct
+{
+	char      name[NAME_MAX];
+	uint32_t  bytes;
+	uint32_t  instructions;
+	uint32_t  calls;
+	uint32_t  cycles;
+} FunctionType;
+
+typedef struct
+{
+	FunctionType  functions[FUNCTIONS_MAX];
+	uint32_t      count;
+} ListingType;
+
+typedef struct
+{
+	const char  *mnemonic;
+	uint8_t     cycles;
+} TimingType;
+
+
+/*** GLOBAL Variablen *********************************************************/
+// ATmega32 instructions of more than one cycle, all others take one
+static const TimingType timings[] =
+{
+	{"adiw", 2}, {"sbiw", 2}, {"mul", 2}, {"muls", 2}, {"mulsu", 2},
+	{"fmul", 2}, {"fmuls", 2}, {"fmulsu", 2},
+	{"ld", 2}, {"ldd", 2}, {"lds", 2}, {"st", 2}, {"std", 2}, {"sts", 2},
+	{"push", 2}, {"pop", 2}, {"cbi", 2}, {"sbi", 2},
+	{"rjmp", 2}, {"ijmp", 2}, {"jmp", 3}, {"rcall", 3}, {"icall", 3},
+	{"call", 4}, {"ret", 4}, {"reti", 4}, {"lpm", 3}, {"elpm", 3},
+};
+
+static ListingType  listing;
+static ListingType  reference;
+
+
+/*******************************************************************************
+***  PRIVATE FUNCTIONS  ********************************************************
+*******************************************************************************/
+// Cycles of an instruction
+static uint8_t Cycles (const char *mnemonic)
+{
+	for (size_t i = 0; i < sizeof timings / sizeof timings[0]; i++)
+	{
+		if (strcmp(mnemonic, timings[i].mnemonic) == 0)
+		{
+			return timings[i].cycles;
+		}
+	}
+	return 1;
+}
+
+// Read the disassembly of an .lss file
+static int ReadListing (const char *path, ListingType *list)
+{
+	FILE          *file = fopen(path, "r");
+	char          line[LINE_MAX];
+	FunctionType  *function = NULL;
+
+	if (!file)
+	{
+		perror(path);
+		return 0;
+	}
+
+	while (fgets(line, sizeof line, file))
+	{
+		char      name[NAME_MAX];
+		char      mnemonic[16];
+		unsigned  address;
+		char      *code;
+		uint32_t  bytes = 0;
+
+		// "00000484 <SetOutput>:", labels starting with '.' are local
+		if (sscanf(line, "%x <%79[^>]>:", &address, name) == 2)
+		{
+			if (name[0] == '.')
+			{
+				continue;
+			}
+			if (list->count == FUNCTIONS_MAX)
+			{
+				fprintf(stderr, "%s: more than %d functions\n", path, FUNCTIONS_MAX);
+				fclose(file);
+				return 0;
+			}
+			function = &list->functions[list->count++];
+			memset(function, 0, sizeof *function);
+			snprintf(function->name, sizeof function->name, "%s", name);
+			continue;
+		}
+
+		// "  484:\t0f 93       \tpush\tr16", source lines have no tab
+		code = strchr(line, '\t');
+		if (!function || !code || sscanf(line, " %x:", &address) != 1)
+		{
+			continue;
+		}
+		// the bytes of the instruction: hex pairs up to the next tab
+		for (code++; code[0] != '\t' && code[0] != '\0'; code++)
+		{
+			if (code[0] != ' ' && (code[1] == ' ' || code[1] == '\t'))
+			{
+				bytes++;
+			}
+		}
+		if (code[0] != '\t' || sscanf(code, " %15s", mnemonic) != 1 || mnemonic[0] == '.')
+		{
+			continue;  // .word of data in the code
+		}
+		function->bytes += bytes;
+		function->instructions++;
+		function->cycles += Cycles(mnemonic);
+		if (strcmp(mnemonic, "call") == 0 || strcmp(mnemonic, "rcall") == 0 || strcmp(mnemonic, "icall") == 0)
+		{
+			function->calls++;
+		}
+	}
+	fclose(file);
+	return 1;
+}
+
+// Function of a listing by name, NULL if it is not there
+static const FunctionType *FindFunction (const ListingType *list, const char *name)
+{
+	for (uint32_t i = 0; i < list->count; i++)
+	{
+		if (strcmp(list->functions[i].name, name) == 0)
+		{
+			return &list->functions[i];
+		}
+	}
+	return NULL;
+}
+
+// Print a function with the difference to the reference
+static void PrintFunction (const FunctionType *function, const FunctionType *before, int compare)
+{
+	static const FunctionType none;
+
+	printf("  %-32s %6lu %6lu %6lu %6lu", function->name, (unsigned long)function->bytes,
+	       (unsigned long)function->instructions, (unsigned long)function->calls, (unsigned long)function->cycles);
+	if (compare)
+	{
+		if (!before)
+		{
+			before = &none;
+		}
+		printf("  %+6ld %+6ld", (long)function->bytes - (long)before->bytes,
+		       (long)function->cycles - (long)before->cycles);
+	}
+	printf("\n");
+}
+
+
+/*******************************************************************************
+*** MAIN PROGRAM
+*******************************************************************************/
+int main (int argc, char *argv[])
+{
+	static const FunctionType gone;
+	FunctionType              total = {"total", 0, 0, 0, 0};
+	FunctionType              totalBefore = {"total", 0, 0, 0, 0};
+	int                       compare = argc == 3;
+
+	if (argc < 2 || argc > 3)
+	{
+		fprintf(stderr, "usage: %s <lss> [<reference lss>]\n", argv[0]);
+		return 1;
+	}
+	if (!ReadListing(argv[1], &listing) || (compare && !ReadListing(argv[2], &reference)))
+	{
+		return 1;
+	}
+
+	printf("%s%s%s\n", argv[1], compare ? " against " : "", compare ? argv[2] : "");
+	printf("  %-32s %6s %6s %6s %6s%s\n", "function", "bytes", "instr", "calls", "cycles",
+	       compare ? "  bytes  cycles" : "");
+	for (uint32_t i = 0; i < listing.count; i++)
+	{
+		const FunctionType *function = &listing.functions[i];
+
+		PrintFunction(function, FindFunction(&reference, function->name), compare);
+		total.bytes += function->bytes;
+		total.instructions += function->instructions;
+		total.calls += function->calls;
+		total.cycles += function->cycles;
+	}
+
+	// functions of the reference that are gone (inlined or removed)
+	for (uint32_t i = 0; compare && i < reference.count; i++)
+	{
+		const FunctionType *function = &reference.functions[i];
+		FunctionType       removed = gone;
+
+		totalBefore.bytes += function->bytes;
+		totalBefore.cycles += function->cycles;
+		if (!FindFunction(&listing, function->name))
+		{
+			snprintf(removed.name, sizeof removed.name, "%.70s (gone)", function->name);
+			PrintFunction(&removed, function, compare);
+		}
+	}
+	PrintFunction(&total, &totalBefore, compare);
+	return 0;
+}
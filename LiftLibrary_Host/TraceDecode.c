@@ -0,0 +1,343 @@
+/******************************************************************************
+* Program:   Lift simulation library (host stand-in)
+* Filename:  TraceDecode.c
+* Version:   1.7
+* Date:      16.10.2026
+*
+* Description:
+* Decoder for the event trace of the controller (Trace.h). Reads a dump of
+* traceBuffer (LIFTSIM_TRACE of the host simulation or a memory dump of
+* the target, any header.depth) and prints the per call latency breakdown:
+*
+*   queued   call accepted -> a trip towards the floor is chosen
+*   close    trip chosen   -> doors closed, cabin starts
+*   travel   cabin starts  -> cabin stops at the floor
+*   open     cabin stops   -> doors open
+*
+* Calls served on a trip towards another floor count the whole trip as
+* travel; a stop chosen on the way counts its travel from there. Times are control ticks (ms). A trace of a group controller
+* (Group.h) is followed car by car and the car is printed with every line.
+*
+*   TraceDecode [-v] <dump>     -v also lists every event
+*
+*******************************************************************************/
+
+/*** INCLUDE FILES ************************************************************/
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Trace.h"
+
+
+/*** OWN DEFINES **************************************************************/
+#define FLOORS_MAX      128
+#define CARS_MAX        (256 >> TRACE_CAR_SHIFT)
+#define NOT_SET         UINT32_MAX
+#define LATENCIES       4
+
+
+/*** OWN DATA TYPES ***********************************************************/
+// state numbers of the controller's StateMachineType
+static const char *stateNames[] = {"Uninitialized", "Waiting", "CloseDoor", "MoveLift", "OpenDoor", "Trouble"};
+static const char *faultNames[] = {"none", "door", "cabin", "watchdog"};
+static const char *speedNames[] = {"Stop", "Slow", "Medium", "Fast"};
+static const char *latencyNames[LATENCIES] = {"queued", "close", "travel", "open"};
+
+typedef struct
+{
+	uint32_t  called;      // NOT_SET = no call pending
+	uint32_t  chosen;
+	uint32_t  started;
+	uint32_t  stopped;
+	uint8_t   cabin;
+} PendingCallType;
+
+
+/*** GLOBAL Variablen *********************************************************/
+static TraceBufferType  header;   // only the fields before record[] are used
+static TraceRecordType  *records;
+static PendingCallType  pending[CARS_MAX][FLOORS_MAX];
+static int16_t          targets[CARS_MAX];   // trip target of every car, -1 = none
+static uint32_t         starts[CARS_MAX];    // start of the running trip
+static uint8_t          moving[CARS_MAX];    // the car is in MoveLift
+static uint8_t          group;    // the trace has events of more than one car
+
+static uint64_t         latencySum[LATENCIES];
+static uint32_t         latencyMax[LATENCIES];
+static uint64_t         totalSum;
+static uint32_t         totalMax;
+static uint32_t         served;
+static uint32_t         cancelled;
+static uint32_t         hallCancelled;
+
+
+/*******************************************************************************
+***  PRIVATE FUNCTIONS  ********************************************************
+*******************************************************************************/
+// Print one event
+static void PrintEvent (const TraceRecordType *record)
+{
+	uint8_t floor = record->arg & TRACE_FLOOR_MASK;
+
+	printf("%10lu  ", (unsigned long)record->tick);
+	if (group)
+	{
+		printf("car %u  ", record->kind >> TRACE_CAR_SHIFT);
+	}
+	switch (record->kind & TRACE_KIND_MASK)
+	{
+		case TraceState:
+			printf("state    %s\n", record->arg < 6 ? stateNames[record->arg] : "?");
+			break;
+		case TraceCall:
+			printf("call     F%u (%s)\n", floor, (record->arg & TRACE_CABIN) ? "cabin" : "hall");
+			break;
+		case TraceCallDropped:
+			printf("dropped  F%u (cabin is there)\n", floor);
+			break;
+		case TraceTarget:
+			printf("target   F%u\n", floor);
+			break;
+		case TraceSpeed:
+			printf("speed    %s\n", record->arg < 4 ? speedNames[record->arg] : "?");
+			break;
+		case TraceDoor:
+			printf("door     F%u %s\n", floor, (record->arg & TRACE_OPEN) ? "open" : "closed");
+			break;
+		case TraceServed:
+			printf("served   F%u\n", floor);
+			break;
+		case TraceCallCancelled:
+			printf("cancel   F%u (%s)\n", floor, (record->arg & TRACE_CABIN) ? "cabin" : "hall");
+			break;
+		case TraceDwell:
+			printf("dwell    %u.%u s\n", record->arg / 10, record->arg % 10);
+			break;
+		case TraceDoorReopened:
+			printf("reopen   F%u (hall call)\n", floor);
+			break;
+		case TracePark:
+			printf("park     F%u\n", floor);
+			break;
+		case TraceFault:
+			printf("fault    %s\n", record->arg < 4 ? faultNames[record->arg] : "?");
+			break;
+		case TraceKeyStuck:
+			printf("stuck    F%u (%s)\n", floor, (record->arg & TRACE_CABIN) ? "cabin" : "hall");
+			break;
+		case TraceResumed:
+			printf("resume   F%u doors %s\n", floor, (record->arg & TRACE_OPEN) ? "open" : "closed");
+			break;
+		default:
+			printf("unknown  kind %u arg %u\n", record->kind, record->arg);
+			break;
+	}
+}
+
+// Follow the calls through the trips of every car and print the served ones
+static void TrackCalls (const TraceRecordType *record)
+{
+	uint8_t          car = record->kind >> TRACE_CAR_SHIFT;
+	int16_t          *target = &targets[car];
+	uint32_t         *started = &starts[car];
+	PendingCallType  *calls = pending[car];
+	uint8_t          floor = record->arg & TRACE_FLOOR_MASK;
+	uint32_t         now = record->tick;
+
+	switch (record->kind & TRACE_KIND_MASK)
+	{
+		case TraceCall:
+			if (calls[floor].called == NOT_SET)
+			{
+				calls[floor].called  = now;
+				calls[floor].chosen  = NOT_SET;
+				calls[floor].started = NOT_SET;
+				calls[floor].stopped = NOT_SET;
+				calls[floor].cabin   = (record->arg & TRACE_CABIN) != 0;
+			}
+			break;
+
+		case TraceTarget:
+			*target = floor;
+			if (calls[floor].called != NOT_SET && moving[car])
+			{
+				// stop on the way: no door time, travel from here
+				calls[floor].chosen  = now;
+				calls[floor].started = now;
+			}
+			else if (calls[floor].called != NOT_SET && calls[floor].chosen == NOT_SET)
+			{
+				calls[floor].chosen = now;
+			}
+			break;
+
+		case TraceState:
+			moving[car] = (record->arg == 3);
+			if (record->arg == 3)       // MoveLift
+			{
+				*started = now;
+			}
+			else if (record->arg == 4 && *target >= 0)  // OpenDoor
+			{
+				calls[*target].stopped = now;
+				if (calls[*target].started == NOT_SET)
+				{
+					calls[*target].started = *started;
+				}
+			}
+			break;
+
+		case TraceDoorReopened:
+		case TracePark:
+			// no call is the target (yet)
+			*target = -1;
+			break;
+
+		case TraceCallCancelled:
+			if (calls[floor].called != NOT_SET && calls[floor].cabin == ((record->arg & TRACE_CABIN) != 0))
+			{
+				calls[floor].called = NOT_SET;
+				calls[floor].cabin ? cancelled++ : hallCancelled++;
+			}
+			break;
+
+		case TraceServed:
+		{
+			PendingCallType *call = &calls[floor];
+			uint32_t        latency[LATENCIES];
+			uint32_t        total;
+
+			if (call->called == NOT_SET)
+			{
+				break;  // accepted before the oldest record
+			}
+			if (call->chosen == NOT_SET || call->started == NOT_SET || call->stopped == NOT_SET)
+			{
+				// served on the way: the whole trip counts as travel
+				call->chosen  = call->called;
+				call->started = call->called;
+				call->stopped = (call->stopped != NOT_SET) ? call->stopped : now;
+			}
+			latency[0] = call->chosen - call->called;
+			latency[1] = call->started - call->chosen;
+			latency[2] = call->stopped - call->started;
+			latency[3] = now - call->stopped;
+			total      = now - call->called;
+
+			printf("%10lu  ", (unsigned long)call->called);
+			if (group)
+			{
+				printf("car %u  ", car);
+			}
+			printf("F%-3u %-5s %8lu %8lu %8lu %8lu %8lu\n", floor,
+			       call->cabin ? "cabin" : "hall", (unsigned long)total, (unsigned long)latency[0],
+			       (unsigned long)latency[1], (unsigned long)latency[2], (unsigned long)latency[3]);
+
+			for (uint8_t i = 0; i < LATENCIES; i++)
+			{
+				latencySum[i] += latency[i];
+				latencyMax[i] = (latency[i] > latencyMax[i]) ? latency[i] : latencyMax[i];
+			}
+			totalSum += total;
+			totalMax = (total > totalMax) ? total : totalMax;
+			served++;
+			call->called = NOT_SET;
+			break;
+		}
+
+		default:
+			break;
+	}
+}
+
+
+/*******************************************************************************
+*** MAIN PROGRAM
+*******************************************************************************/
+int main (int argc, char *argv[])
+{
+	int       verbose = (argc > 2 && strcmp(argv[1], "-v") == 0);
+	FILE      *file;
+	uint32_t  count;
+	uint32_t  first;
+
+	if (argc != 2 + verbose)
+	{
+		fprintf(stderr, "usage: %s [-v] <trace dump>\n", argv[0]);
+		return 2;
+	}
+	file = fopen(argv[1 + verbose], "rb");
+	if (!file)
+	{
+		perror(argv[1 + verbose]);
+		return 1;
+	}
+	if (fread(&header, offsetof(TraceBufferType, record), 1, file) != 1
+	    || memcmp(header.magic, TRACE_MAGIC, sizeof(header.magic)) != 0
+	    || header.depth == 0 || header.head >= header.depth)
+	{
+		fprintf(stderr, "%s: not a trace dump\n", argv[1 + verbose]);
+		return 1;
+	}
+	records = malloc(header.depth * sizeof(TraceRecordType));
+	if (!records || fread(records, sizeof(TraceRecordType), header.depth, file) != header.depth)
+	{
+		fprintf(stderr, "%s: trace dump is cut short\n", argv[1 + verbose]);
+		return 1;
+	}
+	fclose(file);
+
+	for (uint16_t car = 0; car < CARS_MAX; car++)
+	{
+		targets[car] = -1;
+		starts[car]  = NOT_SET;
+		for (uint16_t floor = 0; floor < FLOORS_MAX; floor++)
+		{
+			pending[car][floor].called = NOT_SET;
+		}
+	}
+
+	// oldest record first
+	count = (header.total < header.depth) ? header.total : header.depth;
+	first = (header.total < header.depth) ? 0 : header.head;
+	for (uint32_t i = 0; i < count; i++)
+	{
+		group |= (records[(first + i) % header.depth].kind >> TRACE_CAR_SHIFT) != 0;
+	}
+	printf("%lu records, %lu lost to wrap-around\n", (unsigned long)count, (unsigned long)(header.total - count));
+
+	if (verbose)
+	{
+		for (uint32_t i = 0; i < count; i++)
+		{
+			PrintEvent(&records[(first + i) % header.depth]);
+		}
+		printf("\n");
+	}
+
+	printf("%10s  %s%-4s %-5s %8s %8s %8s %8s %8s\n", "call [ms]", group ? "car    " : "", "flr", "from", "total", "queued", "close", "travel", "open");
+	for (uint32_t i = 0; i < count; i++)
+	{
+		TrackCalls(&records[(first + i) % header.depth]);
+	}
+
+	if (cancelled > 0)
+	{
+		printf("\n%lu cabin calls cancelled\n", (unsigned long)cancelled);
+	}
+	if (hallCancelled > 0)
+	{
+		printf("\n%lu hall calls cancelled\n", (unsigned long)hallCancelled);
+	}
+	if (served > 0)
+	{
+		printf("\n%lu calls served, average / max [ms]:\n", (unsigned long)served);
+		printf("  %-8s %8lu %8lu\n", "total", (unsigned long)(totalSum / served), (unsigned long)totalMax);
+		for (uint8_t i = 0; i < LATENCIES; i++)
+		{
+			printf("  %-8s %8lu %8lu\n", latencyNames[i], (unsigned long)(latencySum[i] / served), (unsigned long)latencyMax[i]);
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,34 @@
+/******************************************************************************
+* Program:   Lift simulation library (host stand-in)
+* Filename:  avr/eeprom.h
+*
+* Description:
+* Host replacement for the avr-libc EEPROM functions. The EEPROM of the
+* ATmega32 (E2END + 1 bytes, erased to 0xFF) is an image in the simulation
+* (LiftEeprom.c) that LIFTSIM_EEPROM keeps in a file from run to run. A
+* write takes EEPROM_WRITE_US of simulated time like the real cell: the CPU
+* goes on, the next write waits for it. Addresses are plain numbers cast to
+* pointers, EEMEM variables are not supported.
+*
+*******************************************************************************/
+#ifndef LIFTSIM_AVR_EEPROM_H_
+#define LIFTSIM_AVR_EEPROM_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <avr/io.h>
+
+uint8_t eeprom_read_byte (const uint8_t *address);
+void    eeprom_read_block (void *destination, const void *source, size_t size);
+void    eeprom_write_byte (uint8_t *address, uint8_t value);
+void    eeprom_update_byte (uint8_t *address, uint8_t value);
+void    eeprom_update_block (const void *source, void *destination, size_t size);
+
+// no write in progress (EEWE clear)
+uint8_t LiftEepromReady (void);
+void    LiftEepromBusyWait (void);
+
+#define eeprom_is_ready()       LiftEepromReady()
+#define eeprom_busy_wait()      LiftEepromBusyWait()
+
+#endif /* LIFTSIM_AVR_EEPROM_H_ */
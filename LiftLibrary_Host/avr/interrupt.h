@@ -0,0 +1,26 @@
+/******************************************************************************
+* Program:   Lift simulation library (host stand-in)
+* Filename:  avr/interrupt.h
+*
+* Description:
+* Host replacement for the avr-libc interrupt handling. An ISR becomes a
+* plain function that the simulation runtime calls when the modelled timer
+* reaches its compare value; sei() / cli() switch the global interrupt flag
+* of the model.
+*
+*******************************************************************************/
+#ifndef LIFTSIM_AVR_INTERRUPT_H_
+#define LIFTSIM_AVR_INTERRUPT_H_
+
+#include "LiftSim.h"
+
+#define ISR(vector, ...)	void vector (void)
+
+#define sei()	LiftSimInterrupts(1)
+#define cli()	LiftSimInterrupts(0)
+
+// vectors the runtime knows about
+void TIMER0_COMP_vect (void);
+void TIMER1_COMPA_vect (void);
+
+#endif /* LIFTSIM_AVR_INTERRUPT_H_ */
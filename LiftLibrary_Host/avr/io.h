@@ -0,0 +1,75 @@
+/******************************************************************************
+* Program:   Lift simulation library (host stand-in)
+* Filename:  avr/io.h
+*
+* Description:
+* Host replacement for the ATmega32 I/O register definitions. The registers
+* used by the lift model are plain variables owned by the simulation
+* runtime (LiftSim.c); PIND is driven by the button scenario. Timer0 and
+* Timer1 are modelled in CTC mode only (see LiftSim.c).
+*
+*******************************************************************************/
+#ifndef LIFTSIM_AVR_IO_H_
+#define LIFTSIM_AVR_IO_H_
+
+#include <stdint.h>
+
+extern volatile uint8_t PORTA, DDRA, PINA;
+extern volatile uint8_t PORTB, DDRB, PINB;
+extern volatile uint8_t PORTC, DDRC, PINC;
+extern volatile uint8_t PORTD, DDRD, PIND;
+
+// timers and MCU control
+extern volatile uint8_t  TCCR0, TCNT0, OCR0, TIMSK, TIFR, MCUCR, MCUCSR;
+extern volatile uint8_t  TCCR1A, TCCR1B;
+extern volatile uint16_t TCNT1, OCR1A;
+
+// last EEPROM address (avr/eeprom.h)
+#define E2END   0x3FF
+
+// TCCR0
+#define FOC0    7
+#define WGM00   6
+#define COM01   5
+#define COM00   4
+#define WGM01   3
+#define CS02    2
+#define CS01    1
+#define CS00    0
+
+// TCCR1B
+#define ICNC1   7
+#define ICES1   6
+#define WGM13   4
+#define WGM12   3
+#define CS12    2
+#define CS11    1
+#define CS10    0
+
+// TIMSK / TIFR
+#define OCIE2   7
+#define TOIE2   6
+#define TICIE1  5
+#define OCIE1A  4
+#define OCIE1B  3
+#define TOIE1   2
+#define OCIE0   1
+#define TOIE0   0
+#define OCF1A   4
+#define OCF0    1
+
+// MCUCSR: reset cause
+#define WDRF    3
+#define BORF    2
+#define EXTRF   1
+#define PORF    0
+
+// MCUCR
+#define SE      7
+#define SM2     6
+#define SM1     5
+#define SM0     4
+
+#define _BV(bit)	(1 << (bit))
+
+#endif /* LIFTSIM_AVR_IO_H_ */
@@ -0,0 +1,24 @@
+/******************************************************************************
+* Program:   Lift simulation library (host stand-in)
+* Filename:  avr/pgmspace.h
+*
+* Description:
+* Host replacement for the avr-libc program memory access. The host has one
+* address space, so PROGMEM data is ordinary constant data and the
+* pgm_read_*() functions read it directly.
+*
+*******************************************************************************/
+#ifndef LIFTSIM_AVR_PGMSPACE_H_
+#define LIFTSIM_AVR_PGMSPACE_H_
+
+#include <stdint.h>
+
+#define PROGMEM
+#define PSTR(s)                 (s)
+
+#define pgm_read_byte(addr)     (*(const uint8_t *)(addr))
+#define pgm_read_word(addr)     (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr)    (*(const uint32_t *)(addr))
+#define pgm_read_ptr(addr)      (*(void * const *)(addr))
+
+#endif /* LIFTSIM_AVR_PGMSPACE_H_ */
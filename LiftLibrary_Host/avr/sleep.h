@@ -0,0 +1,28 @@
+/******************************************************************************
+* Program:   Lift simulation library (host stand-in)
+* Filename:  avr/sleep.h
+*
+* Description:
+* Host replacement for the avr-libc sleep functions. Sleeping hands the
+* simulated clock over to the runtime until the next enabled interrupt.
+*
+*******************************************************************************/
+#ifndef LIFTSIM_AVR_SLEEP_H_
+#define LIFTSIM_AVR_SLEEP_H_
+
+#include <avr/io.h>
+#include "LiftSim.h"
+
+#define SLEEP_MODE_IDLE         0
+#define SLEEP_MODE_ADC          _BV(SM0)
+#define SLEEP_MODE_PWR_DOWN     _BV(SM1)
+#define SLEEP_MODE_PWR_SAVE     (_BV(SM0) | _BV(SM1))
+#define SLEEP_MODE_STANDBY      (_BV(SM1) | _BV(SM2))
+
+#define set_sleep_mode(mode)	(MCUCR = (MCUCR & ~(_BV(SM0) | _BV(SM1) | _BV(SM2))) | (mode))
+#define sleep_enable()			(MCUCR |= _BV(SE))
+#define sleep_disable()			(MCUCR &= ~_BV(SE))
+#define sleep_cpu()				LiftSimSleep()
+#define sleep_mode()			do { sleep_enable(); sleep_cpu(); sleep_disable(); } while (0)
+
+#endif /* LIFTSIM_AVR_SLEEP_H_ */
@@ -0,0 +1,32 @@
+/******************************************************************************
+* Program:   Lift simulation library (host stand-in)
+* Filename:  avr/wdt.h
+*
+* Description:
+* Host replacement for the avr-libc watchdog functions. The simulation
+* checks the time between two wdt_reset() calls; when it exceeds the
+* timeout the run ends like a watchdog reset would end it (LiftSim.c).
+* Idle passes the simulation skips count as if they had reset it.
+*
+*******************************************************************************/
+#ifndef LIFTSIM_AVR_WDT_H_
+#define LIFTSIM_AVR_WDT_H_
+
+#include <avr/io.h>
+#include "LiftSim.h"
+
+// timeouts of the ATmega32 at 5 V: about 16.3 ms << value
+#define WDTO_15MS       0
+#define WDTO_30MS       1
+#define WDTO_60MS       2
+#define WDTO_120MS      3
+#define WDTO_250MS      4
+#define WDTO_500MS      5
+#define WDTO_1S         6
+#define WDTO_2S         7
+
+#define wdt_enable(value)   LiftSimWatchdog(value)
+#define wdt_disable()       LiftSimWatchdog(LIFTSIM_WDT_OFF)
+#define wdt_reset()         LiftSimWatchdogReset()
+
+#endif /* LIFTSIM_AVR_WDT_H_ */
@@ -0,0 +1,678 @@
+/******************************************************************************
+* Program:   Lift simulation library (host stand-in)
+* Filename:  library.c
+* Version:   4.4-host
+* Date:      16.10.2026
+*
+* Description:
+* Host implementation of LiftLibrary_V4. The model follows the ATmega32
+* library call for call: doors move one step every 5000 SetOutput() calls,
+* the cabin moves one position every (speed + 2) MoveElevator() calls,
+* 16 positions per floor, and the port images on PORTA..PORTC are computed
+* the same way. Time is counted in loop passes, so a run is deterministic
+* and only as slow as the host CPU.
+*
+* Every car of a group (LiftGroup.h) has a model of its own; the library
+* calls work on the selected one. The shaft has LIFT_FLOORS floors with
+* LIFT_STEPS_PER_FLOOR positions (LiftGroup.h); the ports only show the
+* LEDs and doors of the lowest four floors, like the board.
+*
+* A power cycle does not move the cabins: with LIFTSIM_SHAFT the cabin
+* positions and doors of all cars are read from that file at the start
+* (if it exists) and written back at the end of the run, so the next run
+* starts where this one stopped.
+*
+* The scenario can jam a door or the cabin (LiftModelJam()): a jammed door
+* stays where it is, a jammed cabin does not move on MoveElevator().
+*
+* Precondition:  InitializePorts() is called before any other function
+*
+* Postcondition: -
+*
+* Required Libraries:
+* - LiftLibrary.h
+* - LiftSim.h
+* - LiftGroup.h
+*
+*******************************************************************************/
+
+/*** INCLUDE FILES ************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include "LiftLibrary.h"
+#include "LiftSim.h"
+#include "LiftGroup.h"
+
+
+/*** OWN DEFINES **************************************************************/
+#define FLOORS              LIFT_FLOORS
+#define POSITIONS_PER_FLOOR LIFT_STEPS_PER_FLOOR
+#define TOP_POSITION        ((FLOORS - 1) * POSITIONS_PER_FLOOR)
+
+// the ports have LEDs and door select lines for four floors
+#define PORT_FLOORS         ((FLOORS < 4) ? FLOORS : 4)
+
+// the cabin starts somewhere between Floor1 and Floor2
+#define START_POSITION      ((FLOORS > 2) ? 2 * POSITIONS_PER_FLOOR - 1 : POSITIONS_PER_FLOOR - 1)
+#define DOOR_STEPS          4
+#define DOOR_RATE           5000
+#define REPETITION_RATE     13
+
+// approximate CPU cycles of the ATmega32 library functions (call, body, return)
+#define CYCLES_SET_OUTPUT   120
+#define CYCLES_READ_KEY     15
+#define CYCLES_READ_DOOR    20
+#define CYCLES_SET_DOOR     15
+#define CYCLES_MOVE         25
+#define CYCLES_READ_STATE   30
+#define CYCLES_CALIBRATE    10
+#define CYCLES_INDICATOR    12
+
+
+/*** OWN DATA TYPES ***********************************************************/
+typedef struct
+{
+	DoorStateType state;     // requested state (Open / Closed)
+	int8_t        position;  // 0 = closed .. DOOR_STEPS = open
+	uint8_t       jammed;    // fault of the scenario: the door stays
+} DoorType;
+
+// everything of one car: doors, cabin, display and LEDs
+typedef struct
+{
+	uint8_t          car;
+
+	DisplayStateType liftDisplay7Seg_On;
+	LiftPosType      liftDisplay7Seg;
+	uint8_t          floorDisplayPort;
+
+	DisplayStateType buttonLiftLed_on;
+	LiftPosType      buttonLiftLed;
+
+	DisplayStateType buttonFloorLed_On;
+	LiftPosType      buttonFloorLed;
+
+	uint8_t          displayCache;
+
+	DisplayStateType liftPosDisplay_On;
+	uint16_t         liftPosition;
+	uint16_t         liftPositionCache;
+	uint8_t          liftPositionPort;
+
+	DisplayStateType doorframe;
+
+	uint8_t          repetitionRate;
+
+	uint16_t         doorOpeningRate;
+
+	uint16_t         liftSpeed;
+	SpeedType        lastSpeed;       // of the last MoveElevator() call
+	uint64_t         moveCalls;       // MoveElevator() calls so far
+	uint8_t          cabinJammed;     // fault of the scenario: no motion
+
+	DoorType         liftDoorState[FLOORS];
+} CarModelType;
+
+
+/*** GLOBAL Variablen *********************************************************/
+static CarModelType     models[LIFT_CARS_MAX];
+static CarModelType     *model = &models[0];   // selected car
+
+static const DoorPosType doorPositions[DOOR_STEPS + 1] = { Door00, Door25, Door50, Door75, Door100 };
+
+static const uint8_t     doorSelect[4] = { Floor0_D, Floor1_D, Floor2_D, Floor3_D };
+
+static const char        *shaftPath;
+
+
+/*******************************************************************************
+***  PRIVATE FUNCTIONS  ********************************************************
+*******************************************************************************/
+// Move every door one step towards its requested state
+static void MakeDoorStates (void)
+{
+	for (int8_t count = 0; count < FLOORS; count++)
+	{
+		DoorType *door = &model->liftDoorState[count];
+
+		if (door->jammed)
+		{
+			continue;
+		}
+		if (door->state == Closed)
+		{
+			if (door->position > 0)
+			{
+				door->position--;
+				if (door->position == 0)
+				{
+					LiftSimNoteDoor(model->car, (LiftPosType)count, Closed);
+				}
+			}
+		}
+		else if (door->state == Open)
+		{
+			if (door->position < DOOR_STEPS)
+			{
+				door->position++;
+				if (door->position == DOOR_STEPS)
+				{
+					LiftSimNoteDoor(model->car, (LiftPosType)count, Open);
+				}
+			}
+		}
+	}
+}
+
+
+// Write the cabin positions and doors to LIFTSIM_SHAFT, one car per line
+static void SaveShaft (void)
+{
+	FILE *file = fopen(shaftPath, "w");
+
+	if (file == NULL)
+	{
+		fprintf(stderr, "liftsim: cannot write %s\n", shaftPath);
+		return;
+	}
+	for (uint8_t car = 0; car < LIFT_CARS_MAX; car++)
+	{
+		fprintf(file, "%u", models[car].liftPosition);
+		for (uint8_t floor = 0; floor < FLOORS; floor++)
+		{
+			fprintf(file, " %d", models[car].liftDoorState[floor].position);
+		}
+		fprintf(file, "\n");
+	}
+	fclose(file);
+}
+
+// Read the cabin positions and doors of the last run from LIFTSIM_SHAFT
+static void LoadShaft (void)
+{
+	FILE *file;
+
+	shaftPath = getenv("LIFTSIM_SHAFT");
+	if (shaftPath == NULL || *shaftPath == 0)
+	{
+		return;
+	}
+	atexit(SaveShaft);
+	if ((file = fopen(shaftPath, "r")) == NULL)
+	{
+		return;
+	}
+	for (uint8_t car = 0; car < LIFT_CARS_MAX; car++)
+	{
+		CarModelType *start = &models[car];
+		unsigned     position;
+
+		if (fscanf(file, "%u", &position) != 1 || position > TOP_POSITION)
+		{
+			break;
+		}
+		start->liftPosition      = (uint16_t)position;
+		start->liftPositionCache = (uint16_t)position;
+		for (uint8_t floor = 0; floor < FLOORS; floor++)
+		{
+			int door;
+
+			if (fscanf(file, "%d", &door) != 1 || door < 0 || door > DOOR_STEPS)
+			{
+				break;
+			}
+			// a door stopped half way goes on closing
+			start->liftDoorState[floor].position = (int8_t)door;
+			start->liftDoorState[floor].state    = (door == DOOR_STEPS) ? Open : Closed;
+		}
+	}
+	fclose(file);
+}
+
+
+// Tell the runtime when a moving door of the selected car will be done
+static void ScheduleDoor (LiftPosType floor)
+{
+	DoorType *door = &model->liftDoorState[floor];
+	int8_t   target = (door->state == Open) ? DOOR_STEPS : 0;
+	int8_t   steps = (door->position > target) ? door->position - target : target - door->position;
+
+	if (steps > 0 && !door->jammed)
+	{
+		// first step at the next multiple of DOOR_RATE, then every DOOR_RATE
+		uint16_t toFirst = (model->doorOpeningRate % DOOR_RATE) ? DOOR_RATE - model->doorOpeningRate : 0;
+		LiftSimScheduleDoor(model->car, floor, toFirst + (uint32_t)(steps - 1) * DOOR_RATE);
+	}
+}
+
+
+/*******************************************************************************
+***  PUBLIC FUNCTIONS  *********************************************************
+*******************************************************************************/
+// Initialization of ports
+void InitializePorts (void)
+{
+	LiftSimInit();
+
+	DDRB = 0xFF;  // lift position, door frame, cabin LED enable
+	DDRC = 0xFF;  // doors (multiplexed)
+	DDRA = 0xFF;  // 7-seg. display, button LEDs
+	DDRD = 0x00;  // buttons
+}
+
+// Set start state of the system
+void InitializeStart (void)
+{
+	for (uint8_t car = 0; car < LIFT_CARS_MAX; car++)
+	{
+		CarModelType *start = &models[car];
+
+		start->car                = car;
+		start->liftPosDisplay_On  = On;
+		start->buttonLiftLed_on   = On;
+		start->liftDisplay7Seg_On = On;
+		start->buttonFloorLed_On  = On;
+		start->doorframe          = On;
+
+		for (int8_t count = 0; count < FLOORS; count++)
+		{
+			start->liftDoorState[count].state    = Closed;
+			start->liftDoorState[count].position = 0;
+		}
+
+		start->liftPosition = START_POSITION;
+	}
+	LoadShaft();
+}
+
+// Send the calculated output values to the ports
+void SetOutput (void)
+{
+	DisplayStateType buttonLiftLed_on_tmp  = Off;
+	DisplayStateType buttonFloorLed_On_tmp = Off;
+	uint8_t          multiplex;
+
+	LiftSimCharge(CYCLES_SET_OUTPUT);
+
+	// door movement is paced by the number of output refreshes
+	if ((model->doorOpeningRate % DOOR_RATE) == 0)
+	{
+		MakeDoorStates();
+		model->doorOpeningRate = 0;
+	}
+
+	// doors share PORTC and are shown one floor after the other
+	switch (model->repetitionRate)
+	{
+		case 3:
+		case 6:
+		case 9:
+		case 12:
+		{
+			uint8_t floor = model->repetitionRate / 3 - 1;
+			if (floor < PORT_FLOORS)
+			{
+				PORTC = doorPositions[model->liftDoorState[floor].position] | doorSelect[floor];
+			}
+			break;
+		}
+		default:
+		{
+			break;
+		}
+	}
+
+	if (model->repetitionRate == REPETITION_RATE)
+	{
+		model->repetitionRate = 1;
+		multiplex      = 1;
+	}
+	else
+	{
+		model->repetitionRate++;
+		multiplex = model->repetitionRate % 5;
+	}
+	model->doorOpeningRate++;
+
+	// button LEDs share PORTA and are shown one floor after the other
+	if (model->displayCache != 0)
+	{
+		switch (multiplex)
+		{
+			case 0:
+			{
+				if (model->displayCache & 0x10) model->buttonLiftLed  = Floor0;
+				if (model->displayCache & 0x01) model->buttonFloorLed = Floor0;
+				break;
+			}
+			case 1:
+			{
+				if (model->displayCache & 0x20) model->buttonLiftLed  = Floor1;
+				if (model->displayCache & 0x02) model->buttonFloorLed = Floor1;
+				break;
+			}
+			case 2:
+			{
+				if (model->displayCache & 0x40) model->buttonLiftLed  = Floor2;
+				if (model->displayCache & 0x04) model->buttonFloorLed = Floor2;
+				break;
+			}
+			case 3:
+			{
+				if (model->displayCache & 0x80) model->buttonLiftLed  = Floor3;
+				if (model->displayCache & 0x08) model->buttonFloorLed = Floor3;
+				break;
+			}
+			default:
+			{
+				break;
+			}
+		}
+
+		if (model->displayCache & 0xF0)
+		{
+			buttonLiftLed_on_tmp = model->buttonLiftLed_on;
+		}
+		if (model->displayCache & 0x0F)
+		{
+			buttonFloorLed_On_tmp = model->buttonFloorLed_On;
+		}
+	}
+
+	model->liftPositionPort = (model->liftPosDisplay_On == On) ? (uint8_t)(model->liftPosition & 0x3F) : 0x3F;
+	model->floorDisplayPort = (model->liftDisplay7Seg_On == On) ? model->liftDisplay7Seg : 0x07;
+
+	PORTB = model->liftPositionPort | (model->doorframe << 6) | (buttonLiftLed_on_tmp << 7);
+	PORTA = (model->buttonLiftLed << 3) | (model->buttonFloorLed << 5) | model->floorDisplayPort
+	        | (buttonFloorLed_On_tmp << 7);
+
+	LiftSimPass();
+}
+
+// Read the state of a single button
+ButtonStateType ReadKeyEvent (ButtonType button)
+{
+	LiftSimCharge(CYCLES_READ_KEY);
+	return (PIND & button) ? Pressed : Released;
+}
+
+// Read the state of the door on the given floor
+DoorStateType ReadDoorState (LiftPosType floor)
+{
+	DoorStateType state = Moves;
+
+	LiftSimCharge(CYCLES_READ_DOOR);
+	switch (doorPositions[model->liftDoorState[floor].position])
+	{
+		case Door100:
+		{
+			state = Open;
+			break;
+		}
+		case Door00:
+		{
+			state = Closed;
+			break;
+		}
+		default:
+		{
+			break;
+		}
+	}
+
+	return state;
+}
+
+// Request the door on the given floor to open or close
+void SetDoorState (DoorStateType state, LiftPosType floor)
+{
+	DoorType *door = &model->liftDoorState[floor];
+
+	LiftSimCharge(CYCLES_SET_DOOR);
+
+	if (door->state != state && state != Moves)
+	{
+		door->state = state;
+		ScheduleDoor(floor);
+	}
+	door->state = state;
+}
+
+// Move the cabin one call further in the given direction
+void MoveElevator (DirectionType direction, SpeedType speed)
+{
+	LiftSimCharge(CYCLES_MOVE);
+	model->moveCalls++;
+	model->lastSpeed = speed;
+	if (speed == Stop || model->cabinJammed)
+	{
+		return;
+	}
+
+	if (model->liftSpeed <= speed)
+	{
+		model->liftSpeed++;
+		return;
+	}
+
+	model->liftSpeed = 0;
+	if (direction == Up)
+	{
+		if (model->liftPosition <= TOP_POSITION)
+		{
+			model->liftPosition++;
+		}
+	}
+	else if (model->liftPosition > 0)
+	{
+		model->liftPosition--;
+	}
+
+	if ((model->liftPosition % POSITIONS_PER_FLOOR) == 0 && model->liftPosition <= TOP_POSITION)
+	{
+		LiftSimNoteFloor(model->car, (LiftPosType)(model->liftPosition / POSITIONS_PER_FLOOR));
+	}
+}
+
+// Read the cabin position
+LiftPosType ReadElevatorState (void)
+{
+	LiftPosType output;
+
+	LiftSimCharge(CYCLES_READ_STATE);
+	if (model->liftPosition > TOP_POSITION)
+	{
+		output = UpperStop;
+	}
+	else if ((model->liftPosition % POSITIONS_PER_FLOOR) == 0)
+	{
+		output = (LiftPosType)(model->liftPosition / POSITIONS_PER_FLOOR);
+	}
+	else if (model->liftPosition == model->liftPositionCache)
+	{
+		output = LiftStopped;
+	}
+	else
+	{
+		output = LiftMoves;
+	}
+
+	model->liftPositionCache = model->liftPosition;
+	return output;
+}
+
+// Move the cabin towards Floor0
+void CalibrateElevatorPosition (void)
+{
+	LiftSimCharge(CYCLES_CALIBRATE);
+	if (ReadElevatorState() != Floor0)
+	{
+		MoveElevator(Down, Fast);
+	}
+}
+
+// Show a value on the 7-segment display of the cabin
+void SetDisplay (LiftPosType displayValue)
+{
+	LiftSimCharge(CYCLES_INDICATOR);
+	model->liftDisplay7Seg = displayValue;
+}
+
+// Switch the call indicator LED of a floor button on
+void SetIndicatorFloorState (LiftPosType floor)
+{
+	LiftSimCharge(CYCLES_INDICATOR);
+	LiftSimNoteIndicator(model->car, floor, 0, 1);
+	if (floor < PORT_FLOORS)
+	{
+		model->displayCache |= (1 << floor);
+	}
+}
+
+// Switch the call indicator LED of a cabin button on
+void SetIndicatorElevatorState (LiftPosType floor)
+{
+	LiftSimCharge(CYCLES_INDICATOR);
+	LiftSimNoteIndicator(model->car, floor, 1, 1);
+	if (floor < PORT_FLOORS)
+	{
+		model->displayCache |= (1 << (floor + 4));
+	}
+}
+
+// Switch the call indicator LED of a floor button off
+void ClrIndicatorFloorState (LiftPosType floor)
+{
+	LiftSimCharge(CYCLES_INDICATOR);
+	LiftSimNoteIndicator(model->car, floor, 0, 0);
+	if (floor < PORT_FLOORS)
+	{
+		model->displayCache &= ~(1 << floor);
+	}
+}
+
+// Switch the call indicator LED of a cabin button off
+void ClrIndicatorElevatorState (LiftPosType floor)
+{
+	LiftSimCharge(CYCLES_INDICATOR);
+	LiftSimNoteIndicator(model->car, floor, 1, 0);
+	if (floor < PORT_FLOORS)
+	{
+		model->displayCache &= ~(1 << (floor + 4));
+	}
+}
+
+// Advance the pass-counted parts of a car without computing the ports
+void LiftModelSkipPasses (uint8_t car, uint64_t count)
+{
+	CarModelType *selected = model;
+
+	model = &models[car];
+	while (count > 0)
+	{
+		if ((model->doorOpeningRate % DOOR_RATE) == 0)
+		{
+			MakeDoorStates();
+			model->doorOpeningRate = 0;
+		}
+
+		uint64_t chunk = DOOR_RATE - model->doorOpeningRate;
+		if (chunk > count)
+		{
+			chunk = count;
+		}
+		model->doorOpeningRate += chunk;
+		count -= chunk;
+
+		// repetitionRate runs 1..REPETITION_RATE and starts over
+		if (model->repetitionRate == 0)
+		{
+			model->repetitionRate = 1;
+			chunk--;
+		}
+		model->repetitionRate = (uint8_t)((model->repetitionRate - 1 + chunk) % REPETITION_RATE + 1);
+	}
+	model = selected;
+}
+
+// MoveElevator() calls of a car so far
+uint64_t LiftModelMoveCalls (uint8_t car)
+{
+	return models[car].moveCalls;
+}
+
+// MoveElevator() calls like the last one that only count towards the next
+// position; none once the position changed after the last reading
+uint64_t LiftModelMovesLeft (uint8_t car)
+{
+	const CarModelType *selected = &models[car];
+
+	if (selected->liftPosition != selected->liftPositionCache)
+	{
+		return 0;
+	}
+	if (selected->lastSpeed == Stop || selected->cabinJammed)
+	{
+		return UINT64_MAX;  // the calls do not move the cabin
+	}
+	return (selected->liftSpeed <= selected->lastSpeed) ? selected->lastSpeed + 1 - selected->liftSpeed : 0;
+}
+
+// Count MoveElevator() calls like the last one that stay short of the next
+// position (LiftModelMovesLeft())
+void LiftModelSkipMoves (uint8_t car, uint64_t count)
+{
+	CarModelType *selected = &models[car];
+
+	selected->moveCalls += count;
+	if (selected->lastSpeed != Stop && !selected->cabinJammed)
+	{
+		selected->liftSpeed += (uint16_t)count;
+	}
+}
+
+// Jam or free a door (what < FLOORS) or the cabin of a car
+void LiftModelJam (uint8_t car, uint8_t what, uint8_t on)
+{
+	CarModelType *selected = model;
+
+	model = &models[car];
+	if (what < FLOORS)
+	{
+		model->liftDoorState[what].jammed = on;
+		ScheduleDoor((LiftPosType)what);
+	}
+	else
+	{
+		model->cabinJammed = on;
+	}
+	model = selected;
+}
+
+// Following library calls and PIND refer to this car
+void LiftSelectCar (uint8_t car)
+{
+	if (car < LIFT_CARS_MAX)
+	{
+		model = &models[car];
+		LiftSimSelectCar(car);
+	}
+}
+
+// Buttons of a car without selecting it
+void LiftReadCarButtons (uint8_t car, uint64_t *cabin, uint64_t *floor)
+{
+	LiftSimButtons(car, cabin, floor);
+}
+
+// Light all outputs for a hardware test
+void TestLiftsimulator (void)
+{
+	SetDisplay(Test);
+	model->displayCache = 0xFF;
+	for (int8_t count = 0; count < FLOORS; count++)
+	{
+		model->liftDoorState[count].state = Open;
+	}
+	SetOutput();
+}
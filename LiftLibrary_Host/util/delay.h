@@ -0,0 +1,18 @@
+/******************************************************************************
+* Program:   Lift simulation library (host stand-in)
+* Filename:  util/delay.h
+*
+* Description:
+* Host replacement for the avr-libc busy wait loops. A delay advances the
+* simulated clock instead of burning host time.
+*
+*******************************************************************************/
+#ifndef LIFTSIM_UTIL_DELAY_H_
+#define LIFTSIM_UTIL_DELAY_H_
+
+#include "LiftSim.h"
+
+#define _delay_us(us)	LiftSimDelay((uint32_t)(us))
+#define _delay_ms(ms)	LiftSimDelay((uint32_t)((ms) * 1000UL))
+
+#endif /* LIFTSIM_UTIL_DELAY_H_ */
@@ -0,0 +1,140 @@
+/******************************************************************************
+* Program:   Lift simulation Basic Structure
+* Filename:  DoorDwell.c
+* Version:   1.2
+* Date:      16.10.2026
+*
+* Description:
+* Adaptive door dwell, see DoorDwell.h. The boarding average of a floor is
+* shared by all cars, every car has a running dwell of its own.
+*
+* Required Libraries:
+* - ControlTick.h
+* - Dispatcher.h
+* - Trace.h
+* - Group.h
+*
+*******************************************************************************/
+
+/*** INCLUDE FILES ************************************************************/
+#include "DoorDwell.h"
+#include "ControlTick.h" // CONTROL_TICK_HZ
+#include "Dispatcher.h"  // FLOORS
+#include "Trace.h"
+#include "Group.h"       // currentCar
+
+
+/*** OWN DEFINES **************************************************************/
+#define FALSE               0
+#define TRUE                1
+
+#define MS_TO_TICKS(ms)     ((uint32_t)(ms) * CONTROL_TICK_HZ / 1000)
+
+// boarding average in 1/BOARDING_SCALE passengers per stop
+#define BOARDING_SCALE      16
+#define BOARDINGS_MAX       15    // counted per stop
+
+
+/*** OWN DATA TYPES ***********************************************************/
+typedef struct
+{
+	uint16_t     ticksLeft;    // 0 = doors may close
+	uint16_t     fullTicks;    // dwell of the floor
+	LiftPosType  floor;
+	uint8_t      boardings;    // cabin calls of this stop
+} DwellType;
+
+
+/*** GLOBAL Variablen *********************************************************/
+static uint8_t    boardingAverage[FLOORS];
+
+// running dwell of every car
+static DwellType  dwells[CARS];
+
+
+/*******************************************************************************
+***  PUBLIC FUNCTIONS  *********************************************************
+*******************************************************************************/
+// The doors are open at a floor: start its dwell
+void StartDwell (LiftPosType floor)
+{
+	DwellType *dwell = &dwells[currentCar];
+	uint32_t  ms = DWELL_BASE_MS;
+
+	if (floor < FLOORS)
+	{
+		ms += (uint32_t)boardingAverage[floor] * DWELL_BOARDING_MS / BOARDING_SCALE;
+	}
+	if (ms > DWELL_MAX_MS)
+	{
+		ms = DWELL_MAX_MS;
+	}
+
+	// doors opened again at the same stop keep its boardings
+	if (floor != dwell->floor)
+	{
+		dwell->boardings = 0;
+	}
+	dwell->floor     = floor;
+	dwell->fullTicks = (uint16_t)MS_TO_TICKS(ms);
+	dwell->ticksLeft = dwell->fullTicks;
+	TRACE(TraceDwell, (uint8_t)(ms / 100));
+}
+
+// A call was made at the floor while the doors are open
+void NoteDwellCall (uint8_t cabin)
+{
+	DwellType *dwell = &dwells[currentCar];
+
+	if (cabin)
+	{
+		// the passenger is in, wait a moment for the next one
+		if (dwell->boardings < BOARDINGS_MAX)
+		{
+			dwell->boardings++;
+		}
+		dwell->ticksLeft = (uint16_t)MS_TO_TICKS(DWELL_EARLY_MS);
+	}
+	else
+	{
+		// someone is coming: keep the doors open
+		dwell->ticksLeft = dwell->fullTicks;
+	}
+}
+
+// Count the dwell down
+uint8_t DwellOver (uint8_t ticks)
+{
+	DwellType *dwell = &dwells[currentCar];
+
+	if (dwell->ticksLeft > ticks)
+	{
+		dwell->ticksLeft -= ticks;
+		return FALSE;
+	}
+	dwell->ticksLeft = 0;
+	return TRUE;
+}
+
+// The doors close: the boardings of the stop go into the average
+void EndDwell (void)
+{
+	DwellType *dwell = &dwells[currentCar];
+
+	if (dwell->floor < FLOORS)
+	{
+		uint8_t *average = &boardingAverage[dwell->floor];
+
+		*average = (uint8_t)((*average * (DWELL_HISTORY - 1) + dwell->boardings * BOARDING_SCALE) / DWELL_HISTORY);
+	}
+	dwell->floor     = LIFT_NONE;
+	dwell->ticksLeft = 0;
+}
+
+#ifdef LIFT_SIM
+// Ticks of the dwell still to count
+uint16_t DwellTicksLeft (void)
+{
+	return dwells[currentCar].ticksLeft;
+}
+#endif
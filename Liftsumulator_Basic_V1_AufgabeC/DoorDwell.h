@@ -0,0 +1,74 @@
+/******************************************************************************
+* Program:   Lift simulation Basic Structure
+* Filename:  DoorDwell.h
+* Version:   1.1
+* Date:      16.10.2026
+*
+* Description:
+* Door dwell: how long the doors stay open at a stop before the car leaves
+* for its next target. Every stop starts with the dwell of its floor:
+* DWELL_BASE_MS plus DWELL_BOARDING_MS for every passenger that boarded
+* there on average, up to DWELL_MAX_MS. The average counts the cabin calls
+* made while the doors were open and follows the last stops at the floor
+* (1/DWELL_HISTORY of every new stop), so busy floors keep their doors open
+* longer.
+*
+* A cabin call during the dwell means the passenger is in: the doors close
+* DWELL_EARLY_MS later, unless another call restarts the count. A hall call
+* for the floor keeps the doors open for the whole dwell again; one that
+* comes while the doors close opens them again (main.c).
+*
+* All functions refer to the car selected with SelectCar() (Group.h).
+*
+* Precondition:  -
+*
+* Postcondition: -
+*
+*******************************************************************************/
+#ifndef DOORDWELL_H_
+#define DOORDWELL_H_
+
+/*** INCLUDE FILES ************************************************************/
+#include <stdint.h>
+#include "LiftLibrary.h" // lift model library
+
+
+/*** OWN DEFINES **************************************************************/
+#ifndef DWELL_BASE_MS
+#define DWELL_BASE_MS       2000
+#endif
+
+#ifndef DWELL_BOARDING_MS
+#define DWELL_BOARDING_MS   1000
+#endif
+
+#ifndef DWELL_MAX_MS
+#define DWELL_MAX_MS        6000
+#endif
+
+#ifndef DWELL_EARLY_MS
+#define DWELL_EARLY_MS      800
+#endif
+
+#define DWELL_HISTORY       8     // stops the boarding average follows
+
+
+/*** PUBLIC FUNCTIONS *********************************************************/
+// The doors are open at a floor: start its dwell
+void StartDwell (LiftPosType floor);
+
+// A call was made at the floor while the doors are open
+void NoteDwellCall (uint8_t cabin);
+
+// Count the dwell down, returns TRUE once the doors may close
+uint8_t DwellOver (uint8_t ticks);
+
+// The doors close: the boardings of the stop go into the average
+void EndDwell (void);
+
+#ifdef LIFT_SIM
+// Host simulation: ticks of the dwell still to count, 0 = over
+uint16_t DwellTicksLeft (void);
+#endif
+
+#endif /* DOORDWELL_H_ */
@@ -0,0 +1,263 @@
+/******************************************************************************
+* Program:   Lift simulation Basic Structure
+* Filename:  Fault.c
+* Version:   1.4
+* Date:      16.10.2026
+*
+* Description:
+* Supervision of the cars and recovery from Trouble, see Fault.h.
+*
+* Required Libraries:
+* - avr/io.h
+* - avr/wdt.h
+* - ControlTick.h
+* - Dispatcher.h
+* - Outputs.h
+* - Trace.h
+*
+*******************************************************************************/
+
+/*** INCLUDE FILES ************************************************************/
+#include <avr/io.h>
+#include <avr/wdt.h>
+#include "Fault.h"
+#include "ControlTick.h" // CONTROL_TICK_HZ
+#include "Dispatcher.h"  // calls of the cars
+#include "Outputs.h"     // call indicators
+#include "Trace.h"
+
+
+/*** OWN DEFINES **************************************************************/
+#define FALSE               0
+#define TRUE                1
+
+#define MS_TO_TICKS(ms)     ((uint16_t)((uint32_t)(ms) * CONTROL_TICK_HZ / 1000))
+#define TICKS_MAX           0xFFFF
+
+
+/*** OWN DATA TYPES ***********************************************************/
+// supervision of one car
+typedef struct
+{
+	StateMachineType  state;      // state the time is counted for
+	uint16_t          ticks;      // time in it without progress
+	LiftPosType       position;   // last reading of the position sensor
+	FaultType         fault;      // cause of the last Trouble
+	uint8_t           failures;   // Trouble in a row
+} SupervisionType;
+
+
+/*** GLOBAL Variablen *********************************************************/
+static SupervisionType  supervision[CARS];
+
+
+/*******************************************************************************
+***  PRIVATE FUNCTIONS  ********************************************************
+*******************************************************************************/
+// Give the hall calls of the selected car to the cars still in service
+static void HandOverHallCalls (void)
+{
+#if CARS > 1
+	uint8_t self = currentCar;
+
+	for (CallMaskType calls = GetCarCalls(self, HallCall); calls != 0; calls &= calls - 1)
+	{
+		LiftPosType floor = LOWEST_FLOOR(calls);
+		uint8_t     other = AssignHallCall(floor);
+
+		if (cars[other].state == Trouble)
+		{
+			continue;  // no car left: the call stays
+		}
+		SelectCar(self);
+		CancelHallCall(floor);
+		ClearHallIndicator(floor);
+
+		SelectCar(other);
+		TRACE(TraceCall, floor);
+		AddCall(floor, HallCall);
+		WriteIndicator(floor, FALSE);
+	}
+	SelectCar(self);
+#endif
+}
+
+
+/*******************************************************************************
+***  PUBLIC FUNCTIONS  *********************************************************
+*******************************************************************************/
+// Report a watchdog reset and start the watchdog
+void InitializeFaults (void)
+{
+	for (uint8_t car = 0; car < CARS; car++)
+	{
+		supervision[car].state    = Uninitialized;
+		supervision[car].position = LIFT_NONE;
+	}
+
+	if (MCUCSR & _BV(WDRF))
+	{
+		TRACE(TraceFault, FaultWatchdog);
+	}
+	MCUCSR = 0;
+	wdt_enable(FAULT_WATCHDOG);
+}
+
+// The position sensor of the selected car read this
+void NoteCabinPosition (LiftPosType position)
+{
+	SupervisionType *car = &supervision[currentCar];
+
+	if (position == LiftMoves || position != car->position)
+	{
+		car->ticks = 0;
+	}
+	car->position = position;
+}
+
+// Count the time without progress
+FaultType CheckProgress (const CarType *car, uint8_t ticks)
+{
+	SupervisionType *watched = &supervision[currentCar];
+
+	if (car->state != watched->state)
+	{
+		watched->state = car->state;
+		watched->ticks = 0;
+		return FaultNone;
+	}
+	watched->ticks = (watched->ticks < TICKS_MAX - ticks) ? watched->ticks + ticks : TICKS_MAX;
+
+	switch (car->state)
+	{
+		case CloseDoor:
+		case OpenDoor:
+			if (watched->ticks >= MS_TO_TICKS(FAULT_DOOR_MS))
+			{
+				watched->fault = FaultDoor;
+				return FaultDoor;
+			}
+			return FaultNone;
+
+		case MoveLift:
+		case Uninitialized:
+			if (watched->ticks >= MS_TO_TICKS(FAULT_MOVE_MS))
+			{
+				watched->fault = FaultCabin;
+				return FaultCabin;
+			}
+			return FaultNone;
+
+		default:
+			return FaultNone;
+	}
+}
+
+// The car has gone to Trouble
+void EnterTrouble (void)
+{
+	SupervisionType *watched = &supervision[currentCar];
+
+	TRACE(TraceFault, watched->fault);
+	if (watched->failures < FAULT_RETRIES + 1)
+	{
+		watched->failures++;
+	}
+	HandOverHallCalls();
+}
+
+// Recovery in Trouble
+RecoveryType RecoverCar (void)
+{
+	SupervisionType *watched = &supervision[currentCar];
+
+	if (watched->failures > FAULT_RETRIES)
+	{
+		return RecoveryOutOfService;  // until the next power cycle
+	}
+	if (watched->state != Trouble || watched->ticks < MS_TO_TICKS(FAULT_RETRY_MS))
+	{
+		return RecoveryWait;
+	}
+
+	// a door closes again and the car goes on from the floor, a cabin
+	// homes to Floor0
+	return (watched->fault == FaultDoor) ? RecoveryDoor : RecoveryHome;
+}
+
+#ifdef LIFT_SIM
+// Ticks CheckProgress() counts before the supervision acts
+uint16_t TicksUntilFault (const CarType *car)
+{
+	const SupervisionType *watched = &supervision[currentCar];
+	uint16_t              limit;
+
+	switch (car->state)
+	{
+		case CloseDoor:
+		case OpenDoor:
+			limit = MS_TO_TICKS(FAULT_DOOR_MS);
+			break;
+
+		case MoveLift:
+		case Uninitialized:
+			limit = MS_TO_TICKS(FAULT_MOVE_MS);
+			break;
+
+		case Trouble:
+			if (watched->failures > FAULT_RETRIES)
+			{
+				return UINT16_MAX;
+			}
+			limit = MS_TO_TICKS(FAULT_RETRY_MS);
+			break;
+
+		default:
+			return UINT16_MAX;
+	}
+
+	// a new state starts counting at the next step
+	if (car->state != watched->state)
+	{
+		return 0;
+	}
+	return (watched->ticks + 1 < limit) ? limit - watched->ticks - 1 : 0;
+}
+#endif
+
+// The doors opened at a floor
+void ClearFaults (void)
+{
+	supervision[currentCar].failures = 0;
+}
+
+// A button of a car has been held for KEY_STUCK_MS: its call is cancelled
+void ReportStuckKey (uint8_t index, LiftPosType floor, uint8_t cabin)
+{
+	SelectCar(index);
+	TRACE(TraceKeyStuck, floor | (cabin ? TRACE_CABIN : 0));
+
+	if (cabin)
+	{
+		// usually cancelled by the long press already
+		if (GetCarCalls(index, CabinCall) & FLOOR_BIT(floor))
+		{
+			TRACE(TraceCallCancelled, floor | TRACE_CABIN);
+		}
+		CancelCabinCall(floor);
+		ClearCabinIndicator(floor);
+		return;
+	}
+
+	// the hall call can be with any car of the group
+	for (uint8_t car = 0; car < CARS; car++)
+	{
+		if (GetCarCalls(car, HallCall) & FLOOR_BIT(floor))
+		{
+			SelectCar(car);
+			TRACE(TraceCallCancelled, floor);
+			CancelHallCall(floor);
+			ClearHallIndicator(floor);
+		}
+	}
+}
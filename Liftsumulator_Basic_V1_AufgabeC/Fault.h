@@ -0,0 +1,103 @@
+/******************************************************************************
+* Program:   Lift simulation Basic Structure
+* Filename:  Fault.h
+* Version:   1.3
+* Date:      16.10.2026
+*
+* Description:
+* Fault detection and recovery. Every car is supervised in the states that
+* wait for the hardware:
+* - CloseDoor / OpenDoor: the door has to reach its end position within
+*   FAULT_DOOR_MS
+* - MoveLift / Uninitialized: the position sensor has to show the cabin at
+*   another position within FAULT_MOVE_MS
+* A car that misses its limit goes to Trouble: it stops, its display shows
+* Error and its hall calls are handed to the other cars of the group.
+*
+* After FAULT_RETRY_MS in Trouble the car tries again: a door fault closes
+* the door once more and the car goes on from its floor, a cabin fault
+* homes the car to Floor0 (calibration). A car that fails FAULT_RETRIES
+* times in a row without opening its doors at a floor in between stays in
+* Trouble until the next power cycle. The state changes themselves are
+* made by the state machine (StateMachine.h).
+*
+* A button that is held for KEY_STUCK_MS (Keys.h) is reported as stuck and
+* its call is cancelled (a car heading there stops with closed doors); it
+* only gives a new call once it has been released.
+*
+* The watchdog resets the controller when the main loop stops for longer
+* than FAULT_WATCHDOG; after such a reset the trace shows a watchdog fault
+* and the cars resume from the EEPROM (Resume.h).
+*
+* The functions refer to the car selected with SelectCar() (Group.h).
+*
+* Precondition:  InitializeTrace() has been called
+*
+* Postcondition: the watchdog runs
+*
+*******************************************************************************/
+#ifndef FAULT_H_
+#define FAULT_H_
+
+/*** INCLUDE FILES ************************************************************/
+#include <stdint.h>
+#include <avr/wdt.h>
+#include "LiftLibrary.h" // lift model library
+#include "Group.h"       // CarType
+
+
+/*** OWN DEFINES **************************************************************/
+#ifndef FAULT_DOOR_MS
+#define FAULT_DOOR_MS       4000
+#endif
+
+#ifndef FAULT_MOVE_MS
+#define FAULT_MOVE_MS       500
+#endif
+
+#ifndef FAULT_RETRY_MS
+#define FAULT_RETRY_MS      5000
+#endif
+
+#define FAULT_RETRIES       3
+#define FAULT_WATCHDOG      WDTO_120MS
+
+
+/*** OWN DATA TYPES ***********************************************************/
+typedef enum {FaultNone = 0, FaultDoor, FaultCabin, FaultWatchdog}
+FaultType;
+
+typedef enum {RecoveryWait = 0, RecoveryDoor, RecoveryHome, RecoveryOutOfService}
+RecoveryType;
+
+
+/*** PUBLIC FUNCTIONS *********************************************************/
+// Report a watchdog reset and start the watchdog
+void InitializeFaults (void);
+
+// The position sensor of the selected car read this (MoveLift, calibration)
+void NoteCabinPosition (LiftPosType position);
+
+// Count the time without progress, returns the fault once a limit is missed
+FaultType CheckProgress (const CarType *car, uint8_t ticks);
+
+// The car has gone to Trouble for the fault CheckProgress() returned
+void EnterTrouble (void);
+
+// Recovery in Trouble, returns what to try next
+RecoveryType RecoverCar (void);
+
+#ifdef LIFT_SIM
+// Host simulation: ticks CheckProgress() counts before it reports a fault
+// or the recovery tries again
+uint16_t TicksUntilFault (const CarType *car);
+#endif
+
+// The doors opened at a floor: the car works again
+void ClearFaults (void);
+
+// A button of a car has been held for KEY_STUCK_MS: report it and cancel
+// its call
+void ReportStuckKey (uint8_t index, LiftPosType floor, uint8_t cabin);
+
+#endif /* FAULT_H_ */
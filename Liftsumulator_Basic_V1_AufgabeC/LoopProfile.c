@@ -0,0 +1,190 @@
+/******************************************************************************
+* Program:   Lift simulation Basic Structure
+* Filename:  LoopProfile.c
+* Version:   1.1
+* Date:      16.10.2026
+*
+* Description:
+* Main loop cycle profiler, see LoopProfile.h.
+*
+* Required Libraries:
+* - ControlTick.h
+*
+*******************************************************************************/
+
+/*** INCLUDE FILES ************************************************************/
+#include "ControlTick.h"
+#include "LoopProfile.h"
+
+#ifdef LIFT_SIM
+#include <stdio.h>
+#include <stdlib.h>
+#include "LiftSim.h"
+#endif
+
+#if PROFILE_ENABLE
+
+/*** GLOBAL Variablen *********************************************************/
+ProfileType     profile;
+
+static uint32_t sectionStart[PROFILE_SECTIONS];
+static uint32_t passStart;
+static uint32_t stepStart;
+static uint8_t  stepState;
+
+
+/*******************************************************************************
+***  PRIVATE FUNCTIONS  ********************************************************
+*******************************************************************************/
+// CPU cycles since start (wraps after 2^32)
+static uint32_t ProfileCycles (void)
+{
+#ifdef LIFT_SIM
+	return (uint32_t)LiftSimCycles();
+#else
+	return GetControlTime() * CONTROL_TIME_CYCLES;
+#endif
+}
+
+// Add a measurement
+static void AddSample (ProfileStatsType *stats, uint32_t cycles)
+{
+	stats->count++;
+	stats->sum += cycles;
+	if (cycles < stats->min)
+	{
+		stats->min = cycles;
+	}
+	if (cycles > stats->max)
+	{
+		stats->max = cycles;
+	}
+}
+
+#ifdef LIFT_SIM
+// Host simulation: print the statistics at the end of the run
+static void PrintStats (const char *name, const ProfileStatsType *stats)
+{
+	double share = profile.pass.sum ? 100.0 * stats->sum / profile.pass.sum : 0.0;
+
+	if (stats->count == 0)
+	{
+		return;
+	}
+	fprintf(stderr, "profile:   %-14s %10lu %8lu %8lu %8lu %6.1f %%\n", name, (unsigned long)stats->count,
+	        (unsigned long)stats->min, (unsigned long)(stats->sum / stats->count), (unsigned long)stats->max, share);
+}
+
+static void ReportProfile (void)
+{
+	static const char *sectionNames[PROFILE_SECTIONS] = {"UpdateDisplay", "ReadState", "SetOutput", "Keys", "StateMachine"};
+	static const char *stateNames[PROFILE_STATES] = {"Uninitialized", "Waiting", "CloseDoor", "MoveLift", "OpenDoor", "Trouble"};
+	uint32_t          most = 1;
+
+	fprintf(stderr, "profile: cycles per loop pass (sleep excluded)\n");
+	fprintf(stderr, "profile:   %-14s %10s %8s %8s %8s %8s\n", "", "count", "min", "avg", "max", "share");
+	PrintStats("pass", &profile.pass);
+	for (uint8_t section = 0; section < PROFILE_SECTIONS; section++)
+	{
+		PrintStats(sectionNames[section], &profile.section[section]);
+	}
+	fprintf(stderr, "profile: state machine step of a car by state\n");
+	for (uint8_t state = 0; state < PROFILE_STATES; state++)
+	{
+		PrintStats(stateNames[state], &profile.state[state]);
+	}
+
+	fprintf(stderr, "profile: pass histogram\n");
+	for (uint8_t bucket = 0; bucket < PROFILE_BUCKETS; bucket++)
+	{
+		most = (profile.histogram[bucket] > most) ? profile.histogram[bucket] : most;
+	}
+	for (uint8_t bucket = 0; bucket < PROFILE_BUCKETS; bucket++)
+	{
+		int bar = (int)(40.0 * profile.histogram[bucket] / most + 0.5);
+
+		fprintf(stderr, "profile:   %2s %6lu %10lu %.*s\n", (bucket < PROFILE_BUCKETS - 1) ? "<" : ">=",
+		        512UL << ((bucket < PROFILE_BUCKETS - 1) ? bucket : bucket - 1),
+		        (unsigned long)profile.histogram[bucket], bar, "########################################");
+	}
+}
+#endif
+
+
+/*******************************************************************************
+***  PUBLIC FUNCTIONS  *********************************************************
+*******************************************************************************/
+// Reset the statistics
+void InitializeProfile (void)
+{
+	ProfileStatsType empty = { 0, UINT32_MAX, 0, 0 };
+
+	for (uint8_t section = 0; section < PROFILE_SECTIONS; section++)
+	{
+		profile.section[section] = empty;
+	}
+	for (uint8_t state = 0; state < PROFILE_STATES; state++)
+	{
+		profile.state[state] = empty;
+	}
+	profile.pass = empty;
+	for (uint8_t bucket = 0; bucket < PROFILE_BUCKETS; bucket++)
+	{
+		profile.histogram[bucket] = 0;
+	}
+
+#ifdef LIFT_SIM
+	atexit(ReportProfile);
+#endif
+}
+
+// Start of a loop pass
+void ProfilePassBegin (void)
+{
+	passStart = ProfileCycles();
+}
+
+// End of a loop pass
+void ProfilePassEnd (void)
+{
+	uint32_t cycles = ProfileCycles() - passStart;
+	uint8_t  bucket = 0;
+
+	AddSample(&profile.pass, cycles);
+
+	for (uint32_t limit = 512; cycles >= limit && bucket < PROFILE_BUCKETS - 1; limit <<= 1)
+	{
+		bucket++;
+	}
+	profile.histogram[bucket]++;
+}
+
+// Start of the state machine step of a car
+void ProfileStepBegin (uint8_t state)
+{
+	stepState = state;
+	stepStart = ProfileCycles();
+}
+
+// End of the state machine step of a car
+void ProfileStepEnd (void)
+{
+	if (stepState < PROFILE_STATES)
+	{
+		AddSample(&profile.state[stepState], ProfileCycles() - stepStart);
+	}
+}
+
+// Start of a section
+void ProfileBegin (ProfileSectionType section)
+{
+	sectionStart[section] = ProfileCycles();
+}
+
+// End of a section
+void ProfileEnd (ProfileSectionType section)
+{
+	AddSample(&profile.section[section], ProfileCycles() - sectionStart[section]);
+}
+
+#endif /* PROFILE_ENABLE */
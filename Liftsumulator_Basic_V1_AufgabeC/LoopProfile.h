@@ -0,0 +1,108 @@
+/******************************************************************************
+* Program:   Lift simulation Basic Structure
+* Filename:  LoopProfile.h
+* Version:   1.1
+* Date:      16.10.2026
+*
+* Description:
+* Cycle profiler of the main loop, built with PROFILE_ENABLE 1. It measures
+* the CPU cycles of every loop pass (without the sleep before it) and of
+* the sections of a pass, and keeps a histogram of the pass time. The state
+* machine step of every car is measured on its own and counted for the
+* state case that car was in, so in a group each car's step goes to its own
+* state.
+*
+* Time source: Timer1 of the control tick (8 cycles resolution) on the
+* target, the exact cycle count of the host simulation there (where the
+* library calls of the cars beyond car 0 cost no cycles, see LiftSim.h).
+* On the target the statistics (profile) can be read in the debugger; the
+* host simulation prints them at the end of the run.
+*
+* Precondition:  InitializeControlTick() has been called
+*
+* Postcondition: -
+*
+*******************************************************************************/
+#ifndef LOOPPROFILE_H_
+#define LOOPPROFILE_H_
+
+/*** INCLUDE FILES ************************************************************/
+#include <stdint.h>
+
+
+/*** OWN DEFINES **************************************************************/
+#ifndef PROFILE_ENABLE
+#define PROFILE_ENABLE      0
+#endif
+
+#define PROFILE_STATES      6   // cases of StateMachineType
+#define PROFILE_BUCKETS     8   // pass time histogram: < 512, < 1k, .. cycles
+
+
+/*** OWN DATA TYPES ***********************************************************/
+typedef enum {ProfileDisplay = 0,   // UpdateDisplay()
+              ProfileReadState,     // ReadElevatorState()
+              ProfileOutput,        // SetOutput() calls of the tick
+              ProfileKeys,          // button scan and call handling
+              ProfileStateMachine,  // state machine (sleep excluded)
+              PROFILE_SECTIONS}
+ProfileSectionType;
+
+typedef struct
+{
+	uint32_t  count;
+	uint32_t  min;     // cycles
+	uint32_t  max;
+	uint64_t  sum;
+} ProfileStatsType;
+
+typedef struct
+{
+	ProfileStatsType  section[PROFILE_SECTIONS];
+	ProfileStatsType  state[PROFILE_STATES];       // step of a car by its state case
+	ProfileStatsType  pass;
+	uint32_t          histogram[PROFILE_BUCKETS];  // passes by cycles
+} ProfileType;
+
+
+/*** PUBLIC FUNCTIONS *********************************************************/
+#if PROFILE_ENABLE
+
+extern ProfileType profile;
+
+// Reset the statistics
+void InitializeProfile (void);
+
+// Start and end of a loop pass
+void ProfilePassBegin (void);
+void ProfilePassEnd (void);
+
+// Start and end of the state machine step of a car, state = state case
+// the step starts in
+void ProfileStepBegin (uint8_t state);
+void ProfileStepEnd (void);
+
+// Start and end of a section
+void ProfileBegin (ProfileSectionType section);
+void ProfileEnd (ProfileSectionType section);
+
+#define PROFILE_PASS_BEGIN()        ProfilePassBegin()
+#define PROFILE_PASS_END()          ProfilePassEnd()
+#define PROFILE_STEP_BEGIN(state)   ProfileStepBegin(state)
+#define PROFILE_STEP_END()          ProfileStepEnd()
+#define PROFILE_BEGIN(section)      ProfileBegin(section)
+#define PROFILE_END(section)        ProfileEnd(section)
+
+#else
+
+#define InitializeProfile()
+#define PROFILE_PASS_BEGIN()
+#define PROFILE_PASS_END()
+#define PROFILE_STEP_BEGIN(state)
+#define PROFILE_STEP_END()
+#define PROFILE_BEGIN(section)
+#define PROFILE_END(section)
+
+#endif
+
+#endif /* LOOPPROFILE_H_ */
@@ -0,0 +1,162 @@
+/******************************************************************************
+* Program:   Lift simulation Basic Structure
+* Filename:  MotionProfile.c
+* Version:   1.4
+* Date:      16.10.2026
+*
+* Description:
+* Trip speed profile, see MotionProfile.h. The speed table is shared,
+* every car of the group has a running trip of its own.
+*
+* Required Libraries:
+* - LiftLibrary.h
+* - Trace.h
+* - Group.h
+*
+*******************************************************************************/
+
+/*** INCLUDE FILES ************************************************************/
+#include "MotionProfile.h"
+#include "Trace.h"
+#include "Group.h"         // currentCar
+
+
+/*** OWN DEFINES **************************************************************/
+#define FALSE               0
+#define TRUE                1
+
+// number of positions until the cabin cruises
+#define RAMP_POSITIONS      (PROFILE_SLOW_POSITIONS + PROFILE_MEDIUM_POSITIONS)
+
+// speed at this many positions from the nearer end of the trip
+#define RAMP_SPEED(position) \
+	(((position) < PROFILE_SLOW_POSITIONS) ? Slow : ((position) < RAMP_POSITIONS) ? Medium : Fast)
+
+
+/*** OWN DATA TYPES ***********************************************************/
+typedef struct
+{
+	SpeedType  speed;
+	uint16_t   positionsDone;
+	uint16_t   positionsLeft;
+	uint16_t   callsLeft;      // MoveElevator() calls to the next position
+} TripType;
+
+
+/*** GLOBAL Variablen *********************************************************/
+// speed by positions to the nearer end of the trip, the last entry cruises
+static const SpeedType  rampSpeed[] =
+{
+	RAMP_SPEED(0), RAMP_SPEED(1), RAMP_SPEED(2), RAMP_SPEED(3),
+	RAMP_SPEED(4), RAMP_SPEED(5), RAMP_SPEED(6), RAMP_SPEED(7)
+};
+
+#if RAMP_POSITIONS >= 8
+#error "rampSpeed has room for ramps of up to 7 positions"
+#endif
+
+// running trip of every car
+static TripType   trips[CARS];
+
+
+/*******************************************************************************
+***  PRIVATE FUNCTIONS  ********************************************************
+*******************************************************************************/
+// Pick the speed for the next position
+static void NextPosition (TripType *trip)
+{
+	uint16_t fromEnd = (trip->positionsDone < trip->positionsLeft) ? trip->positionsDone : trip->positionsLeft - 1;
+
+	if (trip->positionsLeft == 0)
+	{
+		// beyond the computed trip: creep until the floor is reported
+		fromEnd = 0;
+	}
+	if (fromEnd > RAMP_POSITIONS)
+	{
+		fromEnd = RAMP_POSITIONS;
+	}
+	if (rampSpeed[fromEnd] != trip->speed)
+	{
+		trip->speed = rampSpeed[fromEnd];
+		TRACE(TraceSpeed, (trip->speed == Slow) ? 1 : (trip->speed == Medium) ? 2 : 3);
+	}
+	trip->callsLeft = trip->speed + 2;
+}
+
+
+/*******************************************************************************
+***  PUBLIC FUNCTIONS  *********************************************************
+*******************************************************************************/
+// Start a trip
+void StartTrip (LiftPosType from, LiftPosType to)
+{
+	TripType *trip = &trips[currentCar];
+
+	trip->speed         = Stop;
+	trip->positionsDone = 0;
+	trip->positionsLeft = (from < FLOORS && to < FLOORS) ? ((to > from) ? to - from : from - to) * STEPS : 0;
+	NextPosition(trip);
+}
+
+// Speed for the next MoveElevator() call
+SpeedType GetTripSpeed (void)
+{
+	return trips[currentCar].speed;
+}
+
+// Count a MoveElevator() call
+void CountTripMove (void)
+{
+	TripType *trip = &trips[currentCar];
+
+	if (--trip->callsLeft == 0)
+	{
+		trip->positionsDone++;
+		if (trip->positionsLeft > 0)
+		{
+			trip->positionsLeft--;
+		}
+		NextPosition(trip);
+	}
+}
+
+// End the running trip earlier
+uint8_t ShortenTrip (uint16_t positions)
+{
+	TripType *trip = &trips[currentCar];
+	uint16_t left;
+	uint16_t rampDown = 0;
+
+	if (positions >= trip->positionsLeft)
+	{
+		return FALSE;
+	}
+	left = trip->positionsLeft - positions;
+
+	// the table reaches the current speed this many positions from the end
+	while (rampDown < RAMP_POSITIONS && rampSpeed[rampDown] != trip->speed)
+	{
+		rampDown++;
+	}
+	if (left - 1 < rampDown)
+	{
+		return FALSE;
+	}
+	trip->positionsLeft = left;
+	return TRUE;
+}
+
+#ifdef LIFT_SIM
+// MoveElevator() calls to the next position
+uint16_t TripCallsLeft (void)
+{
+	return trips[currentCar].callsLeft;
+}
+
+// Count MoveElevator() calls that stay short of the next position
+void RepeatTripMoves (uint16_t calls)
+{
+	trips[currentCar].callsLeft -= calls;
+}
+#endif
@@ -0,0 +1,70 @@
+/******************************************************************************
+* Program:   Lift simulation Basic Structure
+* Filename:  MotionProfile.h
+* Version:   1.4
+* Date:      16.10.2026
+*
+* Description:
+* Speed profile of a trip. The cabin accelerates through the speed levels
+* of the library (Slow, Medium, Fast), cruises and decelerates the same
+* way before the target. The level only depends on the number of positions
+* to the nearer end of the trip; it is looked up in a constant table that
+* the preprocessor fills from the ramp lengths below. A trip is
+* STEPS positions per floor (LiftConfig.h).
+*
+* A running trip can be shortened to stop at a floor on the way
+* (ShortenTrip()) as long as the positions left are enough to ramp down
+* from the current speed the way the table does.
+*
+* The library moves the cabin one position after speed + 2 MoveElevator()
+* calls, so the profile counts the calls and switches the speed only at a
+* position boundary.
+*
+* StartTrip(), GetTripSpeed() and CountTripMove() refer to the trip of the
+* selected car (Group.h).
+*
+* Precondition:  -
+*
+* Postcondition: -
+*
+*******************************************************************************/
+#ifndef MOTIONPROFILE_H_
+#define MOTIONPROFILE_H_
+
+/*** INCLUDE FILES ************************************************************/
+#include <stdint.h>
+#include "LiftLibrary.h" // lift model library
+#include "Dispatcher.h"  // FLOORS
+#include "LiftConfig.h"  // LIFT_STEPS_PER_FLOOR
+
+
+/*** OWN DEFINES **************************************************************/
+#define STEPS                   LIFT_STEPS_PER_FLOOR  // cabin positions per floor
+
+// positions driven at a level before the next faster one is allowed
+#define PROFILE_SLOW_POSITIONS  1
+#define PROFILE_MEDIUM_POSITIONS 2
+
+
+/*** PUBLIC FUNCTIONS *********************************************************/
+// Start a trip
+void StartTrip (LiftPosType from, LiftPosType to);
+
+// Speed for the next MoveElevator() call
+SpeedType GetTripSpeed (void);
+
+// Count a MoveElevator() call made with GetTripSpeed()
+void CountTripMove (void);
+
+// End the running trip this many positions earlier, FALSE (trip unchanged)
+// if the cabin could not ramp down in time
+uint8_t ShortenTrip (uint16_t positions);
+
+#ifdef LIFT_SIM
+// Host simulation: MoveElevator() calls to the next position, and counting
+// calls that stay short of it
+uint16_t TripCallsLeft (void);
+void RepeatTripMoves (uint16_t calls);
+#endif
+
+#endif /* MOTIONPROFILE_H_ */
@@ -0,0 +1,330 @@
+/******************************************************************************
+* Program:   Lift simulation Basic Structure
+* Filename:  Parking.c
+* Version:   1.4
+* Date:      16.10.2026
+*
+* Description:
+* Parking of idle cars from the hall call statistics, see Parking.h. The
+* statistics are shared by all cars, the idle time and the parking floor
+* are kept per car.
+*
+* Required Libraries:
+* - avr/eeprom.h
+* - ControlTick.h
+* - Dispatcher.h
+* - Group.h
+*
+*******************************************************************************/
+
+/*** INCLUDE FILES ************************************************************/
+#include <avr/eeprom.h>
+#include "Parking.h"
+#include "ControlTick.h" // GetControlTicks()
+#include "Dispatcher.h"  // FLOORS
+#include "Group.h"       // currentCar
+
+#if PARK_ENABLE
+
+/*** OWN DEFINES **************************************************************/
+#define FALSE               0
+#define TRUE                1
+
+#define PARK_MAGIC          0xA9
+#define PARK_DELAY_TICKS    ((uint32_t)PARK_DELAY_MS * CONTROL_TICK_HZ / 1000)
+#define PARK_SLOT_TICKS     ((uint32_t)PARK_SLOT_MIN * 60 * CONTROL_TICK_HZ)
+#define COUNT_MAX           255
+
+// EEPROM bytes compared per pass while saving
+#define SAVE_READS          16
+#define SAVE_DONE           sizeof(ParkingImageType)
+
+#define EEPROM_BYTE(index, offset) \
+	((uint8_t *)(uintptr_t)(PARK_EEPROM_ADDR + (index) * PARK_IMAGE_SIZE + (offset)))
+
+#if PARK_DELAY_MS * CONTROL_TICK_HZ / 1000 > 0xFFFF
+#error "PARK_DELAY_MS exceeds the idle counter"
+#endif
+
+#if PARK_EEPROM_ADDR + PARK_EEPROM_SIZE > E2END + 1
+#error "the call statistics do not fit into the EEPROM"
+#endif
+
+
+/*** OWN DATA TYPES ***********************************************************/
+// RAM copy of the EEPROM image
+typedef struct
+{
+	uint8_t  magic;
+	uint8_t  slots;
+	uint8_t  floors;
+	uint8_t  slot;                        // running slot at the last save
+	uint8_t  sequence;                    // one more than the image before
+	uint8_t  counts[PARK_SLOTS][FLOORS];  // hall calls per slot and floor
+	uint8_t  checksum;
+} ParkingImageType;
+
+
+/*** GLOBAL Variablen *********************************************************/
+static ParkingImageType  image;
+static uint8_t           counted;          // any call in the statistics
+static uint8_t           callsSinceSave;
+static uint16_t          saveCursor = SAVE_DONE;
+static uint8_t           saveIndex;        // image the saves go to, the older one
+static uint8_t           savedSequence;    // of the last complete image
+static uint8_t           runningSlot;      // slot of the day, from the image at power-up
+static uint32_t          slotEnd = PARK_SLOT_TICKS;  // control tick of the next slot
+
+// idle time and parking floor of every car
+static uint16_t          idleTicks[CARS];
+static LiftPosType       parkFloors[CARS];
+
+_Static_assert(sizeof(ParkingImageType) == PARK_IMAGE_SIZE, "PARK_IMAGE_SIZE does not match the image");
+
+
+/*******************************************************************************
+***  PRIVATE FUNCTIONS  ********************************************************
+*******************************************************************************/
+// Checksum of an image without the checksum itself
+static uint8_t Checksum (const ParkingImageType *counts)
+{
+	const uint8_t *bytes = (const uint8_t *)counts;
+	uint8_t       sum = 0;
+
+	for (uint16_t i = 0; i < SAVE_DONE - 1; i++)
+	{
+		sum += bytes[i];
+	}
+	return (uint8_t)~sum;
+}
+
+// Read one of the two images, returns TRUE if it is valid for this build
+static uint8_t ReadImage (uint8_t index, ParkingImageType *counts)
+{
+	eeprom_read_block(counts, EEPROM_BYTE(index, 0), sizeof *counts);
+	return counts->magic == PARK_MAGIC && counts->slots == PARK_SLOTS && counts->floors == FLOORS
+	       && counts->checksum == Checksum(counts);
+}
+
+// Time slot of the day, counted on from the slot saved last; a slot that
+// ended while the CPU slept through a button-less time is caught up here
+static uint8_t CurrentSlot (void)
+{
+	while ((int32_t)(GetControlTicks() - slotEnd) >= 0)
+	{
+		slotEnd     += PARK_SLOT_TICKS;
+		runningSlot  = (runningSlot + 1 < PARK_SLOTS) ? runningSlot + 1 : 0;
+	}
+	return runningSlot;
+}
+
+// Start a save of the image into the older one, unchanged bytes are not
+// written; a save that starts over goes to the same image
+static void StartSave (void)
+{
+	image.sequence = savedSequence + 1;
+	image.checksum = Checksum(&image);
+	saveCursor     = 0;
+	callsSinceSave = 0;
+}
+
+// Another car is parked at the floor
+static uint8_t ParkedByOtherCar (LiftPosType floor)
+{
+	for (uint8_t car = 0; car < CARS; car++)
+	{
+		if (car != currentCar && parkFloors[car] == floor)
+		{
+			return TRUE;
+		}
+	}
+	return FALSE;
+}
+
+
+/*******************************************************************************
+***  PUBLIC FUNCTIONS  *********************************************************
+*******************************************************************************/
+// Load the call statistics from the EEPROM
+void InitializeParking (void)
+{
+	ParkingImageType other;
+	uint8_t          valid = ReadImage(0, &image);
+	uint8_t          otherValid = ReadImage(1, &other);
+
+	// the newer of two valid images is the one after the other in sequence
+	if (otherValid && (!valid || other.sequence == (uint8_t)(image.sequence + 1)))
+	{
+		image     = other;
+		valid     = TRUE;
+		saveIndex = 0;
+	}
+	else
+	{
+		saveIndex = 1;
+	}
+
+	if (!valid)
+	{
+		// erased or another build: start without statistics
+		for (uint8_t slot = 0; slot < PARK_SLOTS; slot++)
+		{
+			for (uint8_t floor = 0; floor < FLOORS; floor++)
+			{
+				image.counts[slot][floor] = 0;
+			}
+		}
+		image.magic  = PARK_MAGIC;
+		image.slots  = PARK_SLOTS;
+		image.floors = FLOORS;
+		image.slot     = 0;
+		image.sequence = 0xFF;
+		saveIndex      = 0;
+	}
+	savedSequence = image.sequence;
+	runningSlot   = image.slot;
+
+	counted = FALSE;
+	for (uint8_t slot = 0; slot < PARK_SLOTS; slot++)
+	{
+		for (uint8_t floor = 0; floor < FLOORS; floor++)
+		{
+			counted |= (image.counts[slot][floor] != 0);
+		}
+	}
+	for (uint8_t car = 0; car < CARS; car++)
+	{
+		parkFloors[car] = LIFT_NONE;
+	}
+}
+
+// Count a hall call of the floor
+void RecordHallCall (LiftPosType floor)
+{
+	uint8_t *counts = image.counts[CurrentSlot()];
+
+	if (counts[floor] == COUNT_MAX)
+	{
+		// age the slot: older calls count half
+		for (uint8_t i = 0; i < FLOORS; i++)
+		{
+			counts[i] >>= 1;
+		}
+	}
+	counts[floor]++;
+	counted = TRUE;
+
+	// a save restarts with the new counts
+	if (++callsSinceSave >= PARK_SAVE_CALLS || saveCursor != SAVE_DONE)
+	{
+		StartSave();
+	}
+}
+
+// Count the idle time of the car
+uint8_t CountParkingDelay (uint8_t ticks)
+{
+	uint16_t *idle = &idleTicks[currentCar];
+
+	if (!counted || *idle >= PARK_DELAY_TICKS)
+	{
+		return FALSE;
+	}
+	*idle = (*idle + ticks < PARK_DELAY_TICKS) ? *idle + ticks : PARK_DELAY_TICKS;
+	return *idle < PARK_DELAY_TICKS;
+}
+
+// Floor the idle car should drive to
+LiftPosType GetParkingFloor (LiftPosType floor)
+{
+	uint8_t     slot = CurrentSlot();
+	uint8_t     next = (slot + 1) % PARK_SLOTS;
+	uint16_t    bestScore = 0;
+	LiftPosType best = LIFT_NONE;
+
+	if (parkFloors[currentCar] != LIFT_NONE)
+	{
+		return LIFT_NONE;  // parked already
+	}
+
+	for (uint8_t i = 0; i < FLOORS; i++)
+	{
+		uint16_t score = 2 * image.counts[slot][i] + image.counts[next][i];
+
+		if (score > bestScore && !ParkedByOtherCar(i))
+		{
+			bestScore = score;
+			best      = i;
+		}
+	}
+
+	parkFloors[currentCar] = best;
+	return (best != floor) ? best : LIFT_NONE;
+}
+
+// The car takes a call
+void ResetParking (void)
+{
+	idleTicks[currentCar]  = 0;
+	parkFloors[currentCar] = LIFT_NONE;
+}
+
+// Save a step of the statistics
+uint8_t SaveParking (void)
+{
+	const uint8_t *bytes = (const uint8_t *)&image;
+
+	// a new slot: keep the phase of the day for the next power-up
+	if (CurrentSlot() != image.slot)
+	{
+		image.slot = runningSlot;
+		StartSave();
+	}
+
+	if (saveCursor == SAVE_DONE || !eeprom_is_ready())
+	{
+		return saveCursor != SAVE_DONE;
+	}
+
+	// write the next changed byte, the EEPROM works on it in the background
+	for (uint8_t reads = 0; reads < SAVE_READS && saveCursor < SAVE_DONE; reads++)
+	{
+		uint8_t *address = EEPROM_BYTE(saveIndex, saveCursor);
+		uint8_t value    = bytes[saveCursor++];
+
+		if (eeprom_read_byte(address) != value)
+		{
+			eeprom_write_byte(address, value);
+			break;
+		}
+	}
+
+	// complete: the next save goes to the other image
+	if (saveCursor == SAVE_DONE)
+	{
+		savedSequence = image.sequence;
+		saveIndex    ^= 1;
+		return FALSE;
+	}
+	return TRUE;
+}
+
+#ifdef LIFT_SIM
+// Ticks the idle car still counts before it may park
+uint16_t ParkingDelayLeft (void)
+{
+	uint16_t idle = idleTicks[currentCar];
+
+	return (counted && idle < PARK_DELAY_TICKS) ? PARK_DELAY_TICKS - idle : 0;
+}
+
+// Ticks up to the next time slot, SaveParking() takes it on that tick
+uint16_t ParkingSlotLeft (void)
+{
+	uint32_t left = slotEnd - GetControlTicks();
+
+	return (left < UINT16_MAX) ? (uint16_t)left : UINT16_MAX;
+}
+#endif
+
+#endif /* PARK_ENABLE */
@@ -0,0 +1,120 @@
+/******************************************************************************
+* Program:   Lift simulation Basic Structure
+* Filename:  Parking.h
+* Version:   1.4
+* Date:      16.10.2026
+*
+* Description:
+* Parking of an idle car. The hall calls are counted per floor and time
+* slot of the day (PARK_SLOTS slots of PARK_SLOT_MIN minutes). The board
+* has no clock: the slots are counted with the control tick, and the slot
+* that is running is saved with the counts at every slot change, so after a
+* power cycle the count goes on at the start of that slot (the time the
+* board was off is lost, the phase of the counts is not). A car that has
+* had nothing to do for PARK_DELAY_MS drives with closed doors to the floor
+* where the next hall call is expected: the floor with the most calls in the running slot,
+* the following slot counting half. In a group every idle car takes the
+* best floor no other parked car stands at. Without any counted calls the
+* car stays where it is.
+*
+* A count that overflows halves all counts of its slot, so the statistics
+* follow a change of the traffic. Every PARK_SAVE_CALLS calls the counts
+* are saved to the EEPROM at PARK_EEPROM_ADDR, one byte per control tick
+* while the EEPROM is ready, so a save never stalls the loop; bytes that
+* did not change are not written. The EEPROM holds two images that are
+* written in turn, each with a sequence number one more than the one
+* before: a save cut short by a power loss only spoils the image it
+* writes, the other one still holds the last complete save. At start the
+* counts are taken from the newer valid image for the floors and slots of
+* the build. Shafts of more than 32 floors (host simulation) count in 4
+* slots by default, so both images fit below the resume records.
+*
+* With PARK_ENABLE 0 the cars stay where they served their last call.
+*
+* The parking functions refer to the car selected with SelectCar() (Group.h).
+*
+* Precondition:  InitializePorts() has been called
+*
+* Postcondition: -
+*
+*******************************************************************************/
+#ifndef PARKING_H_
+#define PARKING_H_
+
+/*** INCLUDE FILES ************************************************************/
+#include <stdint.h>
+#include "LiftLibrary.h" // lift model library
+#include "LiftConfig.h"  // LIFT_FLOORS
+
+
+/*** OWN DEFINES **************************************************************/
+#ifndef PARK_ENABLE
+#define PARK_ENABLE         1
+#endif
+
+#ifndef PARK_DELAY_MS
+#define PARK_DELAY_MS       10000
+#endif
+
+#ifndef PARK_SLOTS
+#if LIFT_FLOORS > 32
+#define PARK_SLOTS          4
+#else
+#define PARK_SLOTS          8
+#endif
+#endif
+
+#ifndef PARK_SLOT_MIN
+#define PARK_SLOT_MIN       (24 * 60 / PARK_SLOTS)
+#endif
+
+#define PARK_SAVE_CALLS     16
+#define PARK_EEPROM_ADDR    0x000
+#define PARK_IMAGE_SIZE     (6 + PARK_SLOTS * FLOORS)  // image with the counts
+#define PARK_EEPROM_SIZE    (2 * PARK_IMAGE_SIZE)      // written in turn
+
+
+/*** PUBLIC FUNCTIONS *********************************************************/
+#if PARK_ENABLE
+
+// Load the call statistics from the EEPROM
+void InitializeParking (void);
+
+// Count a hall call of the floor
+void RecordHallCall (LiftPosType floor);
+
+// Count the idle time of the car, returns TRUE while it is too early to park
+uint8_t CountParkingDelay (uint8_t ticks);
+
+// Floor the idle car should drive to, LIFT_NONE to stay where it is
+LiftPosType GetParkingFloor (LiftPosType floor);
+
+// The car takes a call: it is no longer parked and waits anew when idle
+void ResetParking (void);
+
+// Save a step of the statistics, returns TRUE while a save is running
+uint8_t SaveParking (void);
+
+#ifdef LIFT_SIM
+// Host simulation: ticks the idle car still counts before it may park,
+// 0 = it does not count
+uint16_t ParkingDelayLeft (void);
+
+// Host simulation: ticks up to the next time slot, at most UINT16_MAX
+uint16_t ParkingSlotLeft (void);
+#endif
+
+#else
+
+#define InitializeParking()
+#define RecordHallCall(floor)
+#define CountParkingDelay(ticks)    0
+#define GetParkingFloor(floor)      LIFT_NONE
+#define ResetParking()
+#define SaveParking()               0
+#define ParkingDelayLeft()          0
+#define ParkingSlotLeft()           UINT16_MAX
+
+#endif
+
+#endif /* PARKING_H_ */
@@ -0,0 +1,150 @@
+/******************************************************************************
+* Program:   Lift simulation Basic Structure
+* Filename:  PowerSave.c
+* Version:   1.4
+* Date:      16.10.2026
+*
+* Description:
+* Idle sleep mode between control ticks, see PowerSave.h.
+*
+* Required Libraries:
+* - avr/interrupt.h, avr/sleep.h, avr/wdt.h
+* - LiftLibrary.h
+* - ControlTick.h
+* - Keys.h
+* - Outputs.h
+* - Group.h
+* - StateMachine.h
+* - Parking.h
+*
+*******************************************************************************/
+
+/*** INCLUDE FILES ************************************************************/
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include <avr/wdt.h>
+#include "LiftLibrary.h" // lift model library
+#include "ControlTick.h"
+#include "Keys.h"
+#include "Outputs.h"
+#include "Group.h"
+#include "StateMachine.h"
+#include "Parking.h"
+#include "PowerSave.h"
+
+
+/*******************************************************************************
+***  PRIVATE FUNCTIONS  ********************************************************
+*******************************************************************************/
+// Sleep until the next interrupt, called and left with interrupts disabled.
+// sei() only takes effect after the SLEEP instruction, so an interrupt
+// between the caller's check and the sleep cannot get lost. Every wake-up
+// kicks the watchdog, the sleep itself is no fault.
+static void SleepUntilInterrupt (void)
+{
+	sleep_enable();
+	sei();
+	sleep_cpu();
+	sleep_disable();
+	cli();
+	wdt_reset();
+}
+
+#ifdef LIFT_SIM
+// Host simulation: the ticks the simulation replayed are counted for every
+// car in one go
+static void CountRepeatedTicks (void)
+{
+	uint32_t ticks = TakeRepeatedTicks();
+
+	for (uint8_t car = 0; ticks > 0 && car < CARS; car++)
+	{
+		SelectCar(car);
+		RepeatTicks(&cars[car], ticks);
+	}
+}
+#endif
+
+
+/*******************************************************************************
+***  PUBLIC FUNCTIONS  *********************************************************
+*******************************************************************************/
+// Select idle sleep mode and enable interrupts
+void InitializePowerSave (void)
+{
+	// idle mode keeps the timers running
+	set_sleep_mode(SLEEP_MODE_IDLE);
+	sei();
+}
+
+// Sleep until the next control tick
+uint8_t WaitForControlTick (void)
+{
+	cli();
+	while (!ControlTickPending())
+	{
+		SleepUntilInterrupt();
+	}
+	sei();
+
+#ifdef LIFT_SIM
+	CountRepeatedTicks();
+#endif
+	return TakeControlTicks();
+}
+
+// Sleep until a button changes
+void SleepUntilKeyEvent (void)
+{
+	cli();
+	while (!KeyEventPending())
+	{
+		if (KeysSettled())
+		{
+			WaitForEvent();  // host simulation: every wake-up is alike from here
+		}
+
+		SleepUntilInterrupt();
+
+		// the ticks are only used for the output refresh, which also keeps
+		// the door timing of the library running; one tick's worth per
+		// wake-up, through the pacing and counters of Outputs.c
+		DropControlTicks();
+		sei();
+		for (uint8_t car = 0; car < CARS; car++)
+		{
+			SelectCar(car);
+			RefreshOutputs(1);
+		}
+		cli();
+	}
+	sei();
+}
+
+#ifdef LIFT_SIM
+// The following ticks do the same as this pass
+void RepeatAlikeTicks (void)
+{
+	uint16_t ticks = ParkingSlotLeft();
+
+	// a button that is still timing changes something on its own, and a new
+	// time slot starts a save of the parking statistics
+	if (!KeysSettled() || ticks == 0)
+	{
+		return;
+	}
+	ticks--;
+	for (uint8_t car = 0; car < CARS; car++)
+	{
+		uint16_t alike;
+
+		SelectCar(car);
+		alike = TicksAlike(&cars[car]);
+		if (alike < ticks)
+		{
+			ticks = alike;
+		}
+	}
+	LiftSimRepeat(ticks);
+}
+#endif
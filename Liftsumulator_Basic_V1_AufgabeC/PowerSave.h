@@ -0,0 +1,51 @@
+/******************************************************************************
+* Program:   Lift simulation Basic Structure
+* Filename:  PowerSave.h
+* Version:   1.3
+* Date:      16.10.2026
+*
+* Description:
+* Sleep handling of the controller. Between two control ticks
+* (ControlTick.h) the CPU sleeps in idle mode. While the lift has nothing
+* to do it keeps sleeping until a button changes and only wakes up on every
+* tick to refresh the multiplexed outputs and reset the watchdog (Fault.h).
+*
+* Precondition:  InitializePorts(), InitializeStart() and
+*                InitializeControlTick() have been called
+*
+* Postcondition: global interrupts are enabled
+*
+*******************************************************************************/
+#ifndef POWERSAVE_H_
+#define POWERSAVE_H_
+
+/*** INCLUDE FILES ************************************************************/
+#include <stdint.h>
+
+#ifdef LIFT_SIM
+#include "LiftSim.h"     // host simulation runtime (event queue)
+#define WaitForEvent()	LiftSimWaitForEvent()
+#else
+#define WaitForEvent()
+#define RepeatAlikeTicks()
+#endif
+
+
+/*** PUBLIC FUNCTIONS *********************************************************/
+// Select idle sleep mode and enable interrupts
+void InitializePowerSave (void);
+
+// Sleep until the next control tick, returns the number of ticks due
+uint8_t WaitForControlTick (void);
+
+// Sleep until a button changes, refreshing the outputs on every tick
+void SleepUntilKeyEvent (void);
+
+#ifdef LIFT_SIM
+// Host simulation: the following ticks do the same as this pass until a car
+// gets somewhere or one of its timers runs out; the simulation replays
+// them without the main loop and WaitForControlTick() catches them up
+void RepeatAlikeTicks (void);
+#endif
+
+#endif /* POWERSAVE_H_ */
@@ -0,0 +1,260 @@
+/******************************************************************************
+* Program:   Lift simulation Basic Structure
+* Filename:  Resume.c
+* Version:   1.2
+* Date:      16.10.2026
+*
+* Description:
+* Record of the car states in an EEPROM ring, see Resume.h.
+*
+* Required Libraries:
+* - avr/eeprom.h
+* - LiftLibrary.h
+* - Dispatcher.h
+* - Outputs.h
+* - DoorDwell.h
+* - Parking.h
+* - Trace.h
+*
+*******************************************************************************/
+
+/*** INCLUDE FILES ************************************************************/
+#include <string.h>
+#include <avr/eeprom.h>
+#include "Resume.h"
+#include "LiftLibrary.h" // lift model library
+#include "Dispatcher.h"  // FLOORS, calls
+#include "Outputs.h"     // WriteIndicator()
+#include "DoorDwell.h"   // StartDwell()
+#include "Parking.h"     // PARK_EEPROM_ADDR, PARK_EEPROM_SIZE
+#include "Trace.h"
+
+#if RESUME_ENABLE
+
+/*** OWN DEFINES **************************************************************/
+#define FALSE               0
+#define TRUE                1
+
+#define NO_FLOOR            0xFF  // not waiting at a floor
+
+#define RESUME_SLOTS        ((E2END + 1 - RESUME_EEPROM_ADDR) / sizeof(ResumeRecordType))
+#define SAVE_DONE           sizeof(ResumeRecordType)
+
+// EEPROM bytes compared per pass while saving
+#define SAVE_READS          16
+
+#define EEPROM_BYTE(slot, offset) \
+	((uint8_t *)(uintptr_t)(RESUME_EEPROM_ADDR + (slot) * sizeof(ResumeRecordType) + (offset)))
+
+#if PARK_ENABLE && PARK_EEPROM_ADDR + PARK_EEPROM_SIZE > RESUME_EEPROM_ADDR
+#error "the call statistics overlap the resume records"
+#endif
+
+
+/*** OWN DATA TYPES ***********************************************************/
+typedef struct __attribute__((packed))
+{
+	uint8_t       floor;      // floor the car waits at, NO_FLOOR
+	uint8_t       doorOpen;
+	CallMaskType  cabin;
+	CallMaskType  hall;
+} CarRecordType;
+
+typedef struct __attribute__((packed))
+{
+	uint8_t       sequence;   // one more than the record before
+	uint8_t       floors;     // build of the record
+	uint8_t       cars;
+	CarRecordType car[CARS];
+	uint8_t       checksum;
+} ResumeRecordType;
+
+
+/*** GLOBAL Variablen *********************************************************/
+static ResumeRecordType  saved;     // newest record in the EEPROM
+static ResumeRecordType  next;      // state of the cars in this pass
+static ResumeRecordType  writing;   // record being written
+static uint8_t           slot;      // slot of the newest record
+static uint8_t           restored;  // saved holds a record read at start
+static uint8_t           resumed[CARS];  // ResumeCar() was called
+static uint16_t          saveCursor = SAVE_DONE;
+
+_Static_assert(RESUME_SLOTS >= 2, "the EEPROM has no room for two resume records");
+
+
+/*******************************************************************************
+***  PRIVATE FUNCTIONS  ********************************************************
+*******************************************************************************/
+// Checksum of a record without the checksum itself
+static uint8_t Checksum (const ResumeRecordType *record)
+{
+	const uint8_t *bytes = (const uint8_t *)record;
+	uint8_t       sum = 0;
+
+	for (uint8_t i = 0; i < SAVE_DONE - 1; i++)
+	{
+		sum += bytes[i];
+	}
+	return (uint8_t)~sum;
+}
+
+// Read the record of a slot, returns TRUE if it is valid for this build
+static uint8_t ReadRecord (uint8_t index, ResumeRecordType *record)
+{
+	eeprom_read_block(record, EEPROM_BYTE(index, 0), sizeof *record);
+	return record->floors == FLOORS && record->cars == CARS && record->checksum == Checksum(record);
+}
+
+// Restore the calls of a record for the selected car
+static void RestoreCalls (const CarRecordType *record)
+{
+	for (CallMaskType calls = record->cabin; calls != 0; calls &= calls - 1)
+	{
+		TRACE(TraceCall, LOWEST_FLOOR(calls) | TRACE_CABIN);
+		AddCall(LOWEST_FLOOR(calls), CabinCall);
+		WriteIndicator(LOWEST_FLOOR(calls), TRUE);
+	}
+	for (CallMaskType calls = record->hall; calls != 0; calls &= calls - 1)
+	{
+		TRACE(TraceCall, LOWEST_FLOOR(calls));
+		AddCall(LOWEST_FLOOR(calls), HallCall);
+		WriteIndicator(LOWEST_FLOOR(calls), FALSE);
+	}
+}
+
+
+/*******************************************************************************
+***  PUBLIC FUNCTIONS  *********************************************************
+*******************************************************************************/
+// Load the newest valid record from the EEPROM
+void InitializeResume (void)
+{
+	ResumeRecordType record;
+
+	// the newest record is the valid one whose successor in the ring is
+	// not its next record
+	for (uint8_t index = 0; index < RESUME_SLOTS && !restored; index++)
+	{
+		if (ReadRecord(index, &saved))
+		{
+			uint8_t following = (index + 1) % RESUME_SLOTS;
+
+			if (!ReadRecord(following, &record) || record.sequence != (uint8_t)(saved.sequence + 1))
+			{
+				slot     = index;
+				restored = TRUE;
+			}
+		}
+	}
+
+	if (!restored)
+	{
+		// nothing to resume: the first record goes to slot 0
+		memset(&saved, 0, sizeof saved);
+		saved.sequence = 0xFF;
+		slot           = RESUME_SLOTS - 1;
+		for (uint8_t index = 0; index < CARS; index++)
+		{
+			saved.car[index].floor = NO_FLOOR;
+		}
+	}
+	next = saved;
+}
+
+// Resume the selected car from its record instead of calibrating
+uint8_t ResumeCar (CarType *car)
+{
+	const CarRecordType *record = &saved.car[currentCar];
+	LiftPosType         floor = (LiftPosType)record->floor;
+
+	if (!restored || resumed[currentCar])
+	{
+		return FALSE;
+	}
+	resumed[currentCar] = TRUE;
+	RestoreCalls(record);
+
+	// the sensors must confirm the recorded position and door
+	if (floor >= FLOORS || ReadElevatorState() != floor
+	    || ReadDoorState(floor) != (record->doorOpen ? Open : Closed))
+	{
+		return FALSE;
+	}
+
+	car->currentElevatorState = floor;
+	car->lastFloor            = floor;
+	if (record->doorOpen)
+	{
+		StartDwell(floor);
+	}
+	TRACE(TraceResumed, floor | (record->doorOpen ? TRACE_OPEN : 0));
+	return TRUE;
+}
+
+// Take the state of the selected car into the next record
+void NoteResumeState (const CarType *car)
+{
+	CarRecordType *record = &next.car[currentCar];
+
+	if (car->state == Waiting && car->currentElevatorState < FLOORS)
+	{
+		record->floor    = car->currentElevatorState;
+		record->doorOpen = ReadDoorState(car->currentElevatorState) == Open;
+	}
+	else
+	{
+		record->floor    = NO_FLOOR;
+		record->doorOpen = FALSE;
+	}
+	record->cabin = GetCarCalls(currentCar, CabinCall);
+	record->hall  = GetCarCalls(currentCar, HallCall);
+}
+
+// Save a step of a changed record
+uint8_t SaveResume (void)
+{
+	const uint8_t *bytes = (const uint8_t *)&writing;
+
+	if (saveCursor == SAVE_DONE)
+	{
+		if (memcmp(next.car, saved.car, sizeof next.car) == 0)
+		{
+			return FALSE;
+		}
+
+		// the record keeps the state of this pass until it is written
+		writing          = next;
+		writing.sequence = saved.sequence + 1;
+		writing.floors   = FLOORS;
+		writing.cars     = CARS;
+		writing.checksum = Checksum(&writing);
+		slot             = (slot + 1) % RESUME_SLOTS;
+		saveCursor       = 0;
+	}
+	if (!eeprom_is_ready())
+	{
+		return TRUE;
+	}
+
+	// write the next changed byte, the EEPROM works on it in the background
+	for (uint8_t reads = 0; reads < SAVE_READS && saveCursor < SAVE_DONE; reads++)
+	{
+		uint8_t *address = EEPROM_BYTE(slot, saveCursor);
+		uint8_t value    = bytes[saveCursor++];
+
+		if (eeprom_read_byte(address) != value)
+		{
+			eeprom_write_byte(address, value);
+			break;
+		}
+	}
+
+	if (saveCursor == SAVE_DONE)
+	{
+		saved = writing;
+		return FALSE;
+	}
+	return TRUE;
+}
+
+#endif /* RESUME_ENABLE */
@@ -0,0 +1,75 @@
+/******************************************************************************
+* Program:   Lift simulation Basic Structure
+* Filename:  Resume.h
+* Version:   1.1
+* Date:      16.10.2026
+*
+* Description:
+* Resume after a power cycle without the homing run to Floor0. The last
+* state of every car is kept in the EEPROM: the floor it waits at, whether
+* its doors are open there, and its pending cabin and hall calls. A car
+* that is not waiting at a floor (doors closing, moving, calibrating) is
+* recorded without floor.
+*
+* The records are written round robin into a ring of RESUME_SLOTS slots
+* from RESUME_EEPROM_ADDR to the end of the EEPROM (wear levelling); every
+* record has a sequence number and a checksum and is written one byte per
+* control tick while the EEPROM is ready, the checksum last. A record cut
+* short by a power loss fails its checksum, so the one before it counts.
+*
+* At start the newest valid record is loaded. A car takes its pending calls
+* back in any case; it skips the calibration if it was waiting at a floor,
+* the position sensor shows that floor and the door there reads open or
+* closed as recorded. Otherwise it calibrates as before.
+*
+* With RESUME_ENABLE 0 every start calibrates and the calls are lost.
+*
+* Precondition:  InitializePorts() has been called
+*
+* Postcondition: -
+*
+*******************************************************************************/
+#ifndef RESUME_H_
+#define RESUME_H_
+
+/*** INCLUDE FILES ************************************************************/
+#include <stdint.h>
+#include "Group.h"       // CarType
+
+
+/*** OWN DEFINES **************************************************************/
+#ifndef RESUME_ENABLE
+#define RESUME_ENABLE       1
+#endif
+
+// after the call statistics (Parking.h) up to the end of the EEPROM
+#define RESUME_EEPROM_ADDR  0x240
+
+
+/*** PUBLIC FUNCTIONS *********************************************************/
+#if RESUME_ENABLE
+
+// Load the newest valid record from the EEPROM
+void InitializeResume (void);
+
+// Resume the selected car from its record instead of calibrating, returns
+// TRUE if it is back in service and goes on Waiting (called once, in state
+// Uninitialized)
+uint8_t ResumeCar (CarType *car);
+
+// Take the state of the selected car into the next record
+void NoteResumeState (const CarType *car);
+
+// Save a step of a changed record, returns TRUE while a save is running
+uint8_t SaveResume (void);
+
+#else
+
+#define InitializeResume()
+#define ResumeCar(car)              0
+#define NoteResumeState(car)
+#define SaveResume()                0
+
+#endif
+
+#endif /* RESUME_H_ */
@@ -0,0 +1,411 @@
+/******************************************************************************
+* Program:   Lift simulation Basic Structure
+* Filename:  StateMachine.c
+* Version:   1.3
+* Date:      16.10.2026
+*
+* Description:
+* Transition table and activities of the car state machine, see
+* StateMachine.h. The table is built from the list TRANSITIONS at compile
+* time and stays in flash together with the function tables.
+*
+* Required Libraries:
+* - avr/pgmspace.h
+* - LiftLibrary.h
+* - ControlTick.h
+* - Dispatcher.h
+* - MotionProfile.h
+* - Trace.h
+* - Outputs.h
+* - DoorDwell.h
+* - Parking.h
+* - Resume.h
+* - Fault.h
+*
+*******************************************************************************/
+
+/*** INCLUDE FILES ************************************************************/
+#include <avr/pgmspace.h>
+#include "StateMachine.h"
+#include "LiftLibrary.h"   // lift model library
+#include "ControlTick.h"   // MOVES_PER_TICK, CALIBRATIONS_PER_TICK
+#include "Dispatcher.h"    // pending calls, next target
+#include "MotionProfile.h" // trip speed profile
+#include "Trace.h"         // event trace
+#include "Outputs.h"       // call indicators
+#include "DoorDwell.h"     // door dwell at a stop
+#include "Parking.h"       // parking of idle cars
+#include "Resume.h"        // resume after a power cycle
+#include "Fault.h"         // supervision, Trouble
+
+
+/*** OWN DEFINES **************************************************************/
+#define FALSE               0
+#define TRUE                1
+
+//          state          event           action           next state
+#define TRANSITIONS(X) \
+	X(Uninitialized, EventResumed,   ActionEnter,     Waiting)       \
+	X(Uninitialized, EventHome,      ActionEnter,     OpenDoor)      \
+	X(Uninitialized, EventFault,     ActionTrouble,   Trouble)       \
+	X(Waiting,       EventCall,      ActionStartTrip, CloseDoor)     \
+	X(Waiting,       EventPark,      ActionPark,      CloseDoor)     \
+	X(CloseDoor,     EventClosed,    ActionClosed,    MoveLift)      \
+	X(CloseDoor,     EventReopen,    ActionReopen,    OpenDoor)      \
+	X(CloseDoor,     EventFault,     ActionTrouble,   Trouble)       \
+	X(MoveLift,      EventArrived,   ActionEnter,     OpenDoor)      \
+	X(MoveLift,      EventStopped,   ActionEnter,     Waiting)       \
+	X(MoveLift,      EventFault,     ActionTrouble,   Trouble)       \
+	X(OpenDoor,      EventOpened,    ActionOpened,    Waiting)       \
+	X(OpenDoor,      EventFault,     ActionTrouble,   Trouble)       \
+	X(Trouble,       EventRetryDoor, ActionRetryDoor, CloseDoor)     \
+	X(Trouble,       EventRetryHome, ActionEnter,     Uninitialized)
+
+#define TABLE_ENTRY(state, event, action, next)  [state][event] = {action, next},
+
+
+/*** OWN DATA TYPES ***********************************************************/
+// ActionIgnore (0) marks the events a state does not take
+typedef enum {ActionIgnore = 0, ActionEnter, ActionStartTrip, ActionPark,
+              ActionClosed, ActionReopen, ActionOpened, ActionTrouble,
+              ActionRetryDoor, ACTIONS}
+ActionType;
+
+typedef struct
+{
+	uint8_t  action;    // ActionType
+	uint8_t  next;      // StateMachineType
+} TransitionType;
+
+typedef EventType (*ActivityFunctionType)(CarType *car, uint8_t ticks);
+typedef void (*ActionFunctionType)(CarType *car);
+
+
+/*******************************************************************************
+***  PRIVATE FUNCTIONS  ********************************************************
+*******************************************************************************/
+// --- activities: one step in a state, returns the event ---
+
+// Lift position calibration to ground floor (Floor0)
+static EventType Calibrate (CarType *car, uint8_t ticks)
+{
+	// back at the floor of the last record: no calibration
+	if (ResumeCar(car))
+	{
+		return EventResumed;
+	}
+
+	for (uint16_t moves = CALIBRATIONS_PER_TICK * ticks; moves > 0; moves--)
+	{
+		car->currentElevatorState = ReadElevatorState();
+		NoteCabinPosition(car->currentElevatorState);
+		if (car->currentElevatorState == Floor0)
+		{
+			// open doors if lift is on ground floor
+			return EventHome;
+		}
+		CalibrateElevatorPosition();
+	}
+	return EventNone;
+}
+
+// Waiting for new floor request
+static EventType WaitForCall (CarType *car, uint8_t ticks)
+{
+	// keep the doors open for the dwell of the stop
+	if (!DwellOver(ticks))
+	{
+		return EventNone;
+	}
+
+	car->requestedElevatorPosition = GetNextTarget(car->currentElevatorState, car->elevatorDirection);
+	if (car->requestedElevatorPosition != LIFT_NONE)
+	{
+		return EventCall;
+	}
+	if (CountParkingDelay(ticks))
+	{
+		return EventNone;  // stay awake until it is time to park
+	}
+
+	// the floor of the next expected call, otherwise nothing to do until a
+	// button changes
+	car->requestedElevatorPosition = GetParkingFloor(car->currentElevatorState);
+	return (car->requestedElevatorPosition != LIFT_NONE) ? EventPark : EventIdle;
+}
+
+// Close the door and wait until the door is closed
+static EventType CloseDoors (CarType *car, uint8_t ticks)
+{
+	if (ReadDoorState(car->currentElevatorState) == Closed)
+	{
+		return EventClosed;
+	}
+	WriteDoorState(Closed, car->currentElevatorState);
+	return EventNone;
+}
+
+// Move cabin to the requested floor, MOVES_PER_TICK steps per tick
+static EventType Move (CarType *car, uint8_t ticks)
+{
+	for (uint16_t moves = MOVES_PER_TICK * ticks; moves > 0; moves--)
+	{
+		car->currentElevatorState = ReadElevatorState();
+		NoteCabinPosition(car->currentElevatorState);
+
+		// passing a floor: stop earlier for a call on the way if the cabin
+		// can still ramp down for it
+		if (car->currentElevatorState < FLOORS && car->currentElevatorState != car->requestedElevatorPosition)
+		{
+			LiftPosType stop = GetStopOnTheWay(car->currentElevatorState, car->requestedElevatorPosition, car->elevatorDirection);
+			uint8_t     floorsLess = (stop > car->requestedElevatorPosition)
+			                         ? stop - car->requestedElevatorPosition
+			                         : car->requestedElevatorPosition - stop;
+
+			if (stop != LIFT_NONE && ShortenTrip((uint16_t)floorsLess * STEPS))
+			{
+				TRACE(TraceTarget, stop);
+				car->requestedElevatorPosition = stop;
+			}
+		}
+
+		if (car->currentElevatorState == car->requestedElevatorPosition)
+		{
+			// goal is reached --> open the doors if the floor was called
+			// (SCAN also drives to the end of the shaft without a call)
+			return IsCalled(car->currentElevatorState) ? EventArrived : EventStopped;
+		}
+
+		// speed from the profile of the trip
+		MoveElevator(car->elevatorDirection, GetTripSpeed());
+		CountTripMove();
+	}
+	return EventNone;
+}
+
+// Open the door and wait still the door is open completely
+static EventType OpenDoors (CarType *car, uint8_t ticks)
+{
+	WriteDoorState(Open, car->currentElevatorState);
+	return (ReadDoorState(car->currentElevatorState) == Open) ? EventOpened : EventNone;
+}
+
+// Stopped with Error on the display, try again after a while
+static EventType Recover (CarType *car, uint8_t ticks)
+{
+	switch (RecoverCar())
+	{
+		case RecoveryDoor:
+			return EventRetryDoor;
+
+		case RecoveryHome:
+			return EventRetryHome;
+
+		case RecoveryOutOfService:
+			return EventIdle;
+
+		default:
+			return EventNone;
+	}
+}
+
+// --- actions: run when the car has changed to the next state ---
+
+// Nothing to do but change the state
+static void Enter (CarType *car)
+{
+}
+
+// A call was found: trip to the target with closed doors
+static void StartTarget (CarType *car)
+{
+	if (car->requestedElevatorPosition != car->currentElevatorState)
+	{
+		car->elevatorDirection = car->requestedElevatorPosition > car->currentElevatorState;
+	}
+	TRACE(TraceTarget, car->requestedElevatorPosition);
+	ResetParking();
+	StartTrip(car->currentElevatorState, car->requestedElevatorPosition);
+}
+
+// Trip to the floor of the next expected call
+static void StartPark (CarType *car)
+{
+	car->elevatorDirection = car->requestedElevatorPosition > car->currentElevatorState;
+	TRACE(TracePark, car->requestedElevatorPosition);
+	StartTrip(car->currentElevatorState, car->requestedElevatorPosition);
+}
+
+// The doors are closed: the stop is over
+static void DoorsClosed (CarType *car)
+{
+	TRACE(TraceDoor, car->currentElevatorState);
+	EndDwell();
+}
+
+// A hall call for the floor while the doors close
+static void Reopen (CarType *car)
+{
+	TRACE(TraceDoorReopened, car->currentElevatorState);
+}
+
+// The doors are open: the call of the floor is served
+static void DoorsOpened (CarType *car)
+{
+	TRACE(TraceDoor, car->currentElevatorState | TRACE_OPEN);
+	if (IsCalled(car->currentElevatorState))
+	{
+		TRACE(TraceServed, car->currentElevatorState);
+	}
+	ClearCall(car->currentElevatorState);
+	ClearIndicators(car->currentElevatorState);
+	StartDwell(car->currentElevatorState);
+	ClearFaults();
+}
+
+// Door or cabin that does not get anywhere
+static void Fail (CarType *car)
+{
+	EnterTrouble();
+}
+
+// Close the door again and go on from the floor
+static void RetryDoor (CarType *car)
+{
+	car->requestedElevatorPosition = car->currentElevatorState;
+}
+
+
+/*** CONSTANTS ****************************************************************/
+static const TransitionType transitions[STATES][EVENTS] PROGMEM =
+{
+	TRANSITIONS(TABLE_ENTRY)
+};
+
+static const ActivityFunctionType activities[STATES] PROGMEM =
+{
+	[Uninitialized] = Calibrate,
+	[Waiting]       = WaitForCall,
+	[CloseDoor]     = CloseDoors,
+	[MoveLift]      = Move,
+	[OpenDoor]      = OpenDoors,
+	[Trouble]       = Recover,
+};
+
+static const ActionFunctionType actions[ACTIONS] PROGMEM =
+{
+	[ActionIgnore]    = Enter,
+	[ActionEnter]     = Enter,
+	[ActionStartTrip] = StartTarget,
+	[ActionPark]      = StartPark,
+	[ActionClosed]    = DoorsClosed,
+	[ActionReopen]    = Reopen,
+	[ActionOpened]    = DoorsOpened,
+	[ActionTrouble]   = Fail,
+	[ActionRetryDoor] = RetryDoor,
+};
+
+
+/*******************************************************************************
+***  PUBLIC FUNCTIONS  *********************************************************
+*******************************************************************************/
+// One control step of the selected car
+uint8_t RunStateMachine (CarType *car, uint8_t ticks)
+{
+	ActivityFunctionType activity = (ActivityFunctionType)pgm_read_ptr(&activities[car->state]);
+	EventType            event = activity(car, ticks);
+
+	RaiseEvent(car, event);
+
+	// door or cabin that does not get anywhere
+	if (CheckProgress(car, ticks) != FaultNone)
+	{
+		RaiseEvent(car, EventFault);
+	}
+
+	if (car->currentElevatorState < FLOORS)
+	{
+		car->lastFloor = car->currentElevatorState;
+	}
+	return event == EventIdle;
+}
+
+// Take an event: change the state, then run the action of the transition
+void RaiseEvent (CarType *car, EventType event)
+{
+	const TransitionType *transition = &transitions[car->state][event];
+	uint8_t              action = pgm_read_byte(&transition->action);
+
+	if (action != ActionIgnore)
+	{
+		car->state = (StateMachineType)pgm_read_byte(&transition->next);
+		((ActionFunctionType)pgm_read_ptr(&actions[action]))(car);
+	}
+}
+
+#ifdef LIFT_SIM
+// Ticks after this step that do the same
+uint16_t TicksAlike (const CarType *car)
+{
+	uint16_t ticks = TicksUntilFault(car);
+	uint16_t left;
+
+	switch (car->state)
+	{
+		case Waiting:
+			// up to the end of the dwell or of the parking delay
+			left = DwellTicksLeft();
+			if (left == 0)
+			{
+				left = ParkingDelayLeft();
+			}
+			return (left > 0 && left - 1 < ticks) ? left - 1 : ticks;
+
+		case MoveLift:
+			// passing a floor looks for a stop on the way; the speed
+			// profile changes at the next position
+			if (car->currentElevatorState < FLOORS)
+			{
+				return 0;
+			}
+			left = (TripCallsLeft() - 1) / MOVES_PER_TICK;
+			return (left < ticks) ? left : ticks;
+
+		case CloseDoor:
+		case OpenDoor:
+		case Trouble:
+			return ticks;
+
+		default:
+			return 0;
+	}
+}
+
+// Count the ticks the simulation replayed
+void RepeatTicks (CarType *car, uint32_t ticks)
+{
+	while (ticks > 0)
+	{
+		uint8_t step = (ticks < UINT8_MAX) ? (uint8_t)ticks : UINT8_MAX;
+
+		switch (car->state)
+		{
+			case Waiting:
+			case Trouble:
+				// these activities only count their time
+				RunStateMachine(car, step);
+				break;
+
+			case MoveLift:
+				RepeatTripMoves(MOVES_PER_TICK * step);
+				CheckProgress(car, step);
+				break;
+
+			default:
+				CheckProgress(car, step);
+				break;
+		}
+		ticks -= step;
+	}
+}
+#endif
@@ -0,0 +1,73 @@
+/******************************************************************************
+* Program:   Lift simulation Basic Structure
+* Filename:  StateMachine.h
+* Version:   1.1
+* Date:      16.10.2026
+*
+* Description:
+* State machine of a car as a transition table. Every control step runs
+* the activity of the car's state once: it reads the sensors, drives the
+* doors or the cabin and returns an event. The table in flash gives the
+* action and the next state for the state and the event; an event the
+* state does not know leaves the car where it is. A step looks up at most
+* two transitions: the event of the activity and a fault (Fault.h).
+*
+*   Uninitialized  Resumed   -> Waiting         (Resume.h)
+*                  Home      -> OpenDoor        calibrated at Floor0
+*   Waiting        Call      -> CloseDoor       trip to the next target
+*                  Park      -> CloseDoor       trip to the parking floor
+*   CloseDoor      Closed    -> MoveLift
+*                  Reopen    -> OpenDoor        hall call for the floor
+*   MoveLift       Arrived   -> OpenDoor        at a called floor
+*                  Stopped   -> Waiting         SCAN end without a call
+*   OpenDoor       Opened    -> Waiting         call served, dwell
+*   Trouble        RetryDoor -> CloseDoor
+*                  RetryHome -> Uninitialized
+*   all but Waiting and Trouble: Fault -> Trouble
+*
+* A new state needs its activity and its rows in the table (StateMachine.c).
+*
+* All functions refer to the car selected with SelectCar() (Group.h).
+*
+* Precondition:  InitializeGroup() has been called
+*
+* Postcondition: -
+*
+*******************************************************************************/
+#ifndef STATEMACHINE_H_
+#define STATEMACHINE_H_
+
+/*** INCLUDE FILES ************************************************************/
+#include <stdint.h>
+#include "Group.h"       // CarType, StateMachineType
+
+
+/*** OWN DEFINES **************************************************************/
+#define STATES              (Trouble + 1)
+
+
+/*** OWN DATA TYPES ***********************************************************/
+typedef enum {EventNone = 0, EventIdle, EventResumed, EventHome, EventCall,
+              EventPark, EventClosed, EventReopen, EventArrived, EventStopped,
+              EventOpened, EventFault, EventRetryDoor, EventRetryHome, EVENTS}
+EventType;
+
+
+/*** PUBLIC FUNCTIONS *********************************************************/
+// One control step of the selected car, returns TRUE when it is idle
+uint8_t RunStateMachine (CarType *car, uint8_t ticks);
+
+// Take an event from outside the activities (e.g. a button)
+void RaiseEvent (CarType *car, EventType event);
+
+#ifdef LIFT_SIM
+// Host simulation: ticks after this step in which the car makes the same
+// library calls and only counts its timers on; the doors and the cabin
+// are left to the simulation, which knows when they get somewhere
+uint16_t TicksAlike (const CarType *car);
+
+// Host simulation: count the ticks the simulation replayed for the car
+void RepeatTicks (CarType *car, uint32_t ticks);
+#endif
+
+#endif /* STATEMACHINE_H_ */
@@ -0,0 +1,87 @@
+/******************************************************************************
+* Program:   Lift simulation Basic Structure
+* Filename:  Trace.c
+* Version:   1.1
+* Date:      16.10.2026
+*
+* Description:
+* Event trace ring buffer, see Trace.h.
+*
+* Required Libraries:
+* - ControlTick.h
+* - Group.h
+*
+*******************************************************************************/
+
+/*** INCLUDE FILES ************************************************************/
+#include <string.h>
+#include "ControlTick.h"
+#include "Trace.h"
+#include "Group.h"       // currentCar
+
+#ifdef LIFT_SIM
+#include <stdio.h>
+#include <stdlib.h>
+#endif
+
+#if TRACE_ENABLE
+
+/*** GLOBAL Variablen *********************************************************/
+TraceBufferType traceBuffer;
+
+
+/*******************************************************************************
+***  PRIVATE FUNCTIONS  ********************************************************
+*******************************************************************************/
+#ifdef LIFT_SIM
+// Host simulation: save the buffer to $LIFTSIM_TRACE
+static void SaveTrace (void)
+{
+	const char *name = getenv("LIFTSIM_TRACE");
+	FILE       *file;
+
+	if (!name || !*name)
+	{
+		return;
+	}
+	file = fopen(name, "wb");
+	if (!file)
+	{
+		perror(name);
+		return;
+	}
+	fwrite(&traceBuffer, sizeof(traceBuffer), 1, file);
+	fclose(file);
+}
+#endif
+
+
+/*******************************************************************************
+***  PUBLIC FUNCTIONS  *********************************************************
+*******************************************************************************/
+// Reset the buffer
+void InitializeTrace (void)
+{
+	memcpy(traceBuffer.magic, TRACE_MAGIC, sizeof(traceBuffer.magic));
+	traceBuffer.depth = TRACE_DEPTH;
+	traceBuffer.head  = 0;
+	traceBuffer.total = 0;
+
+#ifdef LIFT_SIM
+	atexit(SaveTrace);
+#endif
+}
+
+// Record an event
+void TraceEvent (TraceKindType kind, uint8_t arg)
+{
+	TraceRecordType *record = &traceBuffer.record[traceBuffer.head];
+
+	record->tick = GetControlTicks();
+	record->kind = kind | (currentCar << TRACE_CAR_SHIFT);
+	record->arg  = arg;
+	traceBuffer.head = (traceBuffer.head + 1) & (TRACE_DEPTH - 1);
+	traceBuffer.total++;
+}
+
+#endif /* TRACE_ENABLE */
@@ -0,0 +1,113 @@
+/******************************************************************************
+* Program:   Lift simulation Basic Structure
+* Filename:  Trace.h
+* Version:   1.5
+* Date:      16.10.2026
+*
+* Description:
+* Binary event trace in RAM. Every record holds the control tick (ms), an
+* event kind and one argument byte; the buffer is a ring of TRACE_DEPTH
+* records, so it always holds the latest events. In a group the car of an
+* event is kept in the upper bits of the kind. Recording a record is a
+* few stores and an index increment.
+*
+* The buffer (traceBuffer) can be saved from the debugger memory view; the
+* host simulation writes it to the file named by LIFTSIM_TRACE at the end
+* of the run. LiftLibrary_Host/TraceDecode.c prints the events and the
+* per call latency breakdown.
+*
+* With TRACE_ENABLE 0 the TRACE() calls compile to nothing.
+*
+* Precondition:  -
+*
+* Postcondition: -
+*
+*******************************************************************************/
+#ifndef TRACE_H_
+#define TRACE_H_
+
+/*** INCLUDE FILES ************************************************************/
+#include <stdint.h>
+
+
+/*** OWN DEFINES **************************************************************/
+#ifndef TRACE_ENABLE
+#define TRACE_ENABLE        1
+#endif
+
+// number of records, a power of two
+#ifndef TRACE_DEPTH
+#ifdef LIFT_SIM
+#define TRACE_DEPTH         16384
+#else
+#define TRACE_DEPTH         64
+#endif
+#endif
+
+#define TRACE_MAGIC         "LTR1"
+
+// argument of TraceCall, TraceDoor
+#define TRACE_CABIN         0x80  // cabin call (else hall call)
+#define TRACE_OPEN          0x80  // door open (else closed)
+#define TRACE_FLOOR_MASK    0x7F
+
+// the record kind holds the car (Group.h) in its upper bits
+#define TRACE_CAR_SHIFT     4
+#define TRACE_KIND_MASK     0x0F
+
+
+/*** OWN DATA TYPES ***********************************************************/
+typedef enum {TraceState = 1,     // new state of the state machine
+              TraceCall,          // call accepted: floor | TRACE_CABIN
+              TraceCallDropped,   // call for the floor the cabin is at
+              TraceTarget,        // next target floor chosen
+              TraceSpeed,         // speed level 0..3 (Stop, Slow, Medium, Fast)
+              TraceDoor,          // door finished: floor | TRACE_OPEN
+              TraceServed,        // doors open at a called floor
+              TraceCallCancelled, // call cancelled: floor | TRACE_CABIN
+              TraceDwell,         // door dwell of the stop [100 ms]
+              TraceDoorReopened,  // hall call while closing: floor
+              TracePark,          // idle car drives to park: floor
+              TraceResumed,       // resumed at start: floor | TRACE_OPEN
+              TraceFault,         // car goes to Trouble: FaultType (Fault.h)
+              TraceKeyStuck}      // button held too long: floor | TRACE_CABIN
+TraceKindType;
+
+typedef struct __attribute__((packed))
+{
+	uint32_t  tick;
+	uint8_t   kind;
+	uint8_t   arg;
+} TraceRecordType;
+
+typedef struct __attribute__((packed))
+{
+	char             magic[4];
+	uint16_t         depth;
+	uint16_t         head;    // next record to write
+	uint32_t         total;   // records written since start
+	TraceRecordType  record[TRACE_DEPTH];
+} TraceBufferType;
+
+
+/*** PUBLIC FUNCTIONS *********************************************************/
+#if TRACE_ENABLE
+
+extern TraceBufferType traceBuffer;
+
+// Reset the buffer
+void InitializeTrace (void);
+
+// Record an event
+void TraceEvent (TraceKindType kind, uint8_t arg);
+
+#define TRACE(kind, arg)    TraceEvent((kind), (arg))
+
+#else
+
+#define InitializeTrace()
+#define TRACE(kind, arg)
+
+#endif
+
+#endif /* TRACE_H_ */
@@ -2,7 +2,7 @@
 * Program:   Lift simulation Basic Structure
 * Filename:  LiftSimulator_Task_BBasic
 * Author:    Werner Odermatt
-* Version:   1.0
+* Version:   1.4
 * Date:	     09.12.2016
 *
 * Development flow(Version, Date, Author, Development step, Time):
@@ -21,83 +21,73 @@
 * Required Libraries:
 * - avr/io.h
 * - LiftLibrary.h
+* - ControlTick.h
+* - Dispatcher.h
+* - PowerSave.h
+* - Trace.h
+* - LoopProfile.h
+* - Outputs.h
+* - Keys.h
+* - Group.h
+* - DoorDwell.h
+* - Parking.h
+* - Resume.h
+* - Fault.h
+* - StateMachine.h
+* - InputLog.h
 *
 * Created Functions:
-* - ConvertButtonTypeToLiftPosType()
-* - CheckKeyEvent()
+* - HandleKey()
+* - CancelKey()
 * - UpdateDisplay()
 *
 * Copyright (c) 2016 by W.Odermatt, CH-6340 Baar
 *******************************************************************************/
 
 /*** OWN DEFINES **************************************************************/
-#define BUFFER_SIZE     3
-#define BUFFER_SUCCESS  0
-#define BUFFER_FAIL     1
 #define FALSE			0
 #define TRUE			1
-#define STEPS			16
 
 
 /*** INCLUDE FILES ************************************************************/
 #include "LiftLibrary.h" // lift model library
+#include "ControlTick.h" // 1 kHz control tick
+#include "Dispatcher.h"  // pending calls, next target
+#include "PowerSave.h"   // sleep while idle
+#include "Trace.h"       // event trace
+#include "LoopProfile.h" // cycle profiler
+#include "Outputs.h"     // output shadow copies
+#include "Keys.h"        // button scan
+#include "Group.h"       // car contexts, hall call assignment
+#include "DoorDwell.h"   // door dwell at a stop
+#include "Parking.h"     // parking of idle cars
+#include "Resume.h"      // resume after a power cycle
+#include "Fault.h"       // supervision, Trouble, watchdog
+#include "StateMachine.h" // transition table of the cars
+#include "InputLog.h"    // button record and replay
 
 
 /*** OWN DATA TYPES ***********************************************************/
-typedef enum {Uninitialized = 0, Waiting, CloseDoor, MoveLift, OpenDoor, Trouble}
-StateMachineType;
 
 
 /*** CONSTANTS ****************************************************************/
 
 
 /*** GLOBAL Variablen *********************************************************/
-StateMachineType  state = Uninitialized;
-LiftPosType       requestedElevatorPosition = None;
-LiftPosType       currentElevatorState = None;
-DirectionType     elevatorDirection = Down;
-
-// ringbuffer for stored requests (floors)
-// has to be initialized with "None"
-// otherwise the buffer is full of requests to floor 0
-LiftPosType		  callBuffer[BUFFER_SIZE] = { None, None, None };
-
-// read and write pointers for buffer
-// initialized with beginning of buffer
-LiftPosType		  *readPointer = callBuffer;
-LiftPosType		  *writePointer = callBuffer;
-
-// flag for inverted state of buffer
-uint8_t			  invert = FALSE;
-
-// variables needed for speed calculation
-SpeedType			currentSpeed;
-int				    stepCounter = 0;
-int			        stepsDone = 0;
-int		            stepsToGoal = 0;
 
 
 /*******************************************************************************
 ***  PRIVATE FUNCTIONS  ********************************************************
 *******************************************************************************/
-// Convert ButtonType to LiftPosType
-LiftPosType ConvertButtonTypeToLiftPosType (ButtonType button);
+// Store the call of a newly pressed button of a car (floor buttons: car 0)
+void HandleKey (uint8_t index, LiftPosType pressedFloor, uint8_t cabin);
 
-// Check if buttons are pressed
-ButtonType CheckKeyEvent ();
+// Cancel the cabin call of a long pressed button of a car
+void CancelKey (uint8_t index, LiftPosType floor);
 
 // Update the 7-Seg. display
 void UpdateDisplay (LiftPosType elevatorState);
 
-// Add a requested floor to the buffer
-uint8_t AddRequestToBuffer(LiftPosType floorRequest);
-
-// Get a request from the buffer if there is one
-uint8_t GetRequestFromBuffer();
-
-// checks which speed is needed
-void GetSpeedType();
-
 
 /*******************************************************************************
 *** MAIN PROGRAM
@@ -107,135 +97,115 @@ int main(void)
 
 	InitializePorts();  // Initialization of ports
 	InitializeStart();  // Set start state of the system
+	InitializeInputLog();  // Button record or replay, before the tick samples
+	InitializeControlTick();  // Control tick timer
+	InitializePowerSave();  // Sleep mode
+	InitializeTrace();  // Event trace
+	InitializeProfile();  // Cycle profiler
+	InitializeOutputs();  // Output shadow copies
+	InitializeGroup();  // Car contexts
+	InitializeParking();  // Call statistics
+	InitializeResume();  // Last state of the cars
+	InitializeFaults();  // Watchdog
 
 	// Endless loop
 	while(1)
 	{
+		// one control step per tick, ticks that were missed are caught up
+		// (up to CONTROL_CATCH_UP_MAX)
+		uint8_t ticks = WaitForControlTick();
+		uint8_t idleCars = 0;
+		uint8_t saving;
+		PROFILE_PASS_BEGIN();
+		wdt_reset();
 
 		// do always
-		UpdateDisplay(currentElevatorState);  // Update the 7-Seg. display (lift)
-		currentElevatorState = ReadElevatorState();
-		SetOutput();               // Send the calculated output values to the ports
-
-		// check if button is pressed
-		ButtonType newKey = CheckKeyEvent();
-		LiftPosType pressedFloor = ConvertButtonTypeToLiftPosType(newKey);
-		
-		// if a button is pressed, check if it is a floor-request
-		// and if it's not the current floor
-		if (pressedFloor <= 3 && pressedFloor != currentElevatorState)
+		for (uint8_t index = 0; index < CARS; index++)
 		{
-			// if call is saved to buffer, set indicators
-			if (!AddRequestToBuffer(pressedFloor))
-			{
-				newKey < 16 ? SetIndicatorElevatorState(pressedFloor)
-				: SetIndicatorFloorState(pressedFloor);
-			}
+			CarType *car = &cars[index];
+
+			SelectCar(index);
+			PROFILE_BEGIN(ProfileDisplay);
+			UpdateDisplay(car->state == Trouble ? LIFT_ERROR : car->currentElevatorState);  // Update the 7-Seg. display (lift)
+			PROFILE_END(ProfileDisplay);
+			PROFILE_BEGIN(ProfileReadState);
+			car->currentElevatorState = ReadElevatorState();
+			NoteCabinPosition(car->currentElevatorState);  // the read clears the motion flag
+			PROFILE_END(ProfileReadState);
+			PROFILE_BEGIN(ProfileOutput);
+			RefreshOutputs(ticks);     // Send the calculated output values to the ports
+			PROFILE_END(ProfileOutput);
 		}
 
-		// Handling state machine
-		switch (state)
+		// debounced button events of all buttons since the last pass
+		PROFILE_BEGIN(ProfileKeys);
+		ClearKeyEvent();
+		for (uint8_t index = 0; index < CARS; index++)
 		{
-			case Uninitialized:
+			KeyEventsType keyEvents;
+
+			TakeKeyEvents(index, &keyEvents);
+			for (CallMaskType keys = keyEvents.pressed.cabin; keys != 0; keys &= keys - 1)
 			{
-				// Lift position calibration to ground floor (Floor0)
-				if (ReadElevatorState() != Floor0)
-				{
-					CalibrateElevatorPosition();
-				}
-				else
-				{
-					// open doors if lift is on ground floor
-					state = OpenDoor;
-				}
-				break;
+				HandleKey(index, LOWEST_FLOOR(keys), TRUE);  // lowest pressed button
 			}
-
-
-			case Waiting:
+			for (CallMaskType keys = keyEvents.pressed.floor; keys != 0; keys &= keys - 1)
 			{
-				// Waiting for new floor request
-				if (!GetRequestFromBuffer())
-				{
-					// request found in buffer -> close doors
-					state = CloseDoor;
-				}
-
-				break;
+				HandleKey(index, LOWEST_FLOOR(keys), FALSE);
 			}
-
-
-			case CloseDoor:
+			for (CallMaskType keys = keyEvents.longPressed.cabin; keys != 0; keys &= keys - 1)
 			{
-				// Close the door and wait until the door is closed
-				if (ReadDoorState(currentElevatorState) != Closed)
-				{
-					SetDoorState(Closed, currentElevatorState);
-				}
-				else
-				{
-					// move lift when doors are closed
-					state = MoveLift;
-				}
-
-				break;
+				CancelKey(index, LOWEST_FLOOR(keys));
 			}
-
-
-			case MoveLift:
+			for (CallMaskType keys = keyEvents.stuck.cabin; keys != 0; keys &= keys - 1)
 			{
-				// Move cabin to the requested floor
-				if (currentElevatorState != requestedElevatorPosition)
-				{
-					// check at which speed to drive
-					GetSpeedType();
-
-					MoveElevator(elevatorDirection, currentSpeed);
-					stepCounter++;
-
-					// steps to next LED is determined by speed
-					// so if speed is reached --> next LED is reached
-					// --> one step to goal is completed
-					if (stepCounter == currentSpeed)
-					{
-						stepsToGoal--;
-						stepsDone++;
-						stepCounter = 0;
-					}
-				}
-				else
-				{
-					// goal is reached --> reset steps to goal
-					stepsToGoal = 0;
-					// open the doors
-					state = OpenDoor;
-				}
-					
-				break;
+				ReportStuckKey(index, LOWEST_FLOOR(keys), TRUE);
 			}
-
-
-			case OpenDoor:
+			for (CallMaskType keys = keyEvents.stuck.floor; keys != 0; keys &= keys - 1)
 			{
-				// Open the door and wait still the door is open completely
-				SetDoorState(Open, currentElevatorState);
-				if (ReadDoorState(currentElevatorState) == Open)
-				{
-					state = Waiting;
-					ClrIndicatorFloorState(currentElevatorState);
-					ClrIndicatorElevatorState(currentElevatorState);
-				}
-				break;
+				ReportStuckKey(index, LOWEST_FLOOR(keys), FALSE);
 			}
+		}
+		PROFILE_END(ProfileKeys);
 
+		// Handling state machines
+		PROFILE_BEGIN(ProfileStateMachine);
+		for (uint8_t index = 0; index < CARS; index++)
+		{
+			SelectCar(index);
+			PROFILE_STEP_BEGIN(cars[index].state);
+			idleCars += RunStateMachine(&cars[index], ticks);
+			PROFILE_STEP_END();
+			NoteResumeState(&cars[index]);
+		}
+		PROFILE_END(ProfileStateMachine);
+		PROFILE_PASS_END();
+
+		for (uint8_t index = 0; index < CARS; index++)
+		{
+			CarType *car = &cars[index];
 
-			case Trouble:
+			if (car->state != car->tracedState)
 			{
-				// Fault condition is not treated
-				break;
+				SelectCar(index);
+				TRACE(TraceState, car->state);
+				car->tracedState = car->state;
 			}
 		}
 
+		// the call statistics and the car states go to the EEPROM a
+		// byte at a time
+		saving = SaveParking();
+		saving |= SaveResume();
+
+		if (idleCars == CARS && !saving)
+		{
+			SleepUntilKeyEvent();
+		}
+		else if (!saving && !PROFILE_ENABLE)
+		{
+			RepeatAlikeTicks();  // host simulation: skip the ticks that only count
+		}
 	}
 
 	return (0);
@@ -246,181 +216,81 @@ int main(void)
 ***  PRIVATE FUNCTIONs *********************************************************
 *******************************************************************************/
 
-// Add a Request to the circular buffer
-uint8_t AddRequestToBuffer(LiftPosType pressedFloor)
+// Store the call of a newly pressed button
+void HandleKey (uint8_t index, LiftPosType pressedFloor, uint8_t cabin)
 {
-	// return fail if buffer is full
-	if (readPointer == writePointer && invert == TRUE) {
-		return BUFFER_FAIL;
-	}
+	CarType *car;
 
-	// return success if requested floor is the current destination
-	// don't save request again but toggle indicator in main function
-	if (pressedFloor == requestedElevatorPosition)
+	// a hall call goes to the car that arrives first
+	if (!cabin)
 	{
-		return BUFFER_SUCCESS;
+		RecordHallCall(pressedFloor);
+		index = AssignHallCall(pressedFloor);
 	}
+	car = &cars[index];
+	SelectCar(index);
 
-	// check if the requested floor is already in the buffer
-	for (int i = 0; i < BUFFER_SIZE; i++)
+	// the cabin is there with open doors: they stay open a while longer
+	if (pressedFloor == car->currentElevatorState && car->state == Waiting
+	    && ReadDoorState(pressedFloor) != Closed)
 	{
-		// return success to toggle indicators but don't save in buffer again
-		if (callBuffer[i] == pressedFloor)
-		{
-			return BUFFER_SUCCESS;
-		}
-	}
-
-	// save request to buffer
-	*writePointer = pressedFloor;
-
-	// move write pointer to next position
-	writePointer++;
-
-	// check if write pointer is at the end of the buffer
-	// if so, set to the beginning again
-	if ( writePointer > &callBuffer[BUFFER_SIZE - 1] ) {
-		writePointer = callBuffer;
-		invert = TRUE;
+		NoteDwellCall(FALSE);
+		return;
 	}
 
-	return BUFFER_SUCCESS;
-}
-
-// Get a Button from the circular buffer
-uint8_t GetRequestFromBuffer()
-{
-	// return fail if no calls are in buffer
-	if (readPointer == writePointer && invert == FALSE) {
-		return BUFFER_FAIL;
-	}
-	
-	// read floor from buffer
-	requestedElevatorPosition = *readPointer;
-
-	// check elevator direction
-	elevatorDirection = requestedElevatorPosition > currentElevatorState;
-
-	// delete the request from the buffer
-	*readPointer = None;
-	
-	// increment read position
-	readPointer++;
-
-	// reset read position to 0 if end of buffer is reached
-	if (readPointer > &callBuffer[BUFFER_SIZE - 1]) {
-		readPointer = callBuffer;
-		invert = FALSE;
-	}
-	
-	return BUFFER_SUCCESS;
-}
-
-// Get the speed of the elevator depending on its position
-void GetSpeedType() {
-
-	if (stepsToGoal == 0)
+	// a hall call while the doors close opens them again
+	if (pressedFloor == car->currentElevatorState && car->state == CloseDoor && !cabin)
 	{
-		stepsDone = 0;
-		stepCounter = 0;
-		stepsToGoal = (requestedElevatorPosition - currentElevatorState) * STEPS;
-
-		if (stepsToGoal < 0)
-		{
-			stepsToGoal = -stepsToGoal;
-		}
+		RaiseEvent(car, EventReopen);
+		return;
 	}
 
-	if (stepsDone < 4 || stepsToGoal < 4)
+	// otherwise only a closed, idle cabin (SCAN stop at the end of the
+	// shaft) takes a call for its floor to open its doors
+	if (pressedFloor == car->currentElevatorState
+	    && (car->state != Waiting || ReadDoorState(pressedFloor) != Closed))
 	{
-		currentSpeed = Slow;
+		TRACE(TraceCallDropped, pressedFloor);
+		return;
 	}
-	else if (stepsDone < 8 || stepsToGoal < 8)
+
+	// a cabin call while the doors are open: a passenger boarded
+	if (cabin && car->state == Waiting && car->currentElevatorState < FLOORS
+	    && ReadDoorState(car->currentElevatorState) != Closed)
 	{
-		currentSpeed = Medium;
+		NoteDwellCall(TRUE);
 	}
-	else
+	if (!IsCalled(pressedFloor))
 	{
-		currentSpeed = Fast;
+		TRACE(TraceCall, pressedFloor | (cabin ? TRACE_CABIN : 0));
 	}
 
+	// save the call and set the indicator
+	AddCall(pressedFloor, cabin ? CabinCall : HallCall);
+	WriteIndicator(pressedFloor, cabin);
 }
 
-// Convert ButtonType to LiftPosType
-LiftPosType ConvertButtonTypeToLiftPosType (ButtonType button)
+// Cancel the cabin call of a long pressed button
+void CancelKey (uint8_t index, LiftPosType floor)
 {
-	LiftPosType retVal = None;
-
-	switch (button)
+	SelectCar(index);
+	if (IsCalled(floor))
 	{
-		case LiftButton_F0:
-		case FloorButton_F0:
-		{
-			retVal = Floor0;
-			break;
-		}
-		case LiftButton_F1:
-		case FloorButton_F1:
-		{
-			retVal = Floor1;
-			break;
-		}
-		case LiftButton_F2:
-		case FloorButton_F2:
-		{
-			retVal = Floor2;
-			break;
-		}
-		case LiftButton_F3:
-		case FloorButton_F3:
-		{
-			retVal = Floor3;
-			break;
-		}
-		default:
-		{
-			//retVal = None;
-			break;
-		}
+		TRACE(TraceCallCancelled, floor | TRACE_CABIN);
 	}
 
-	return retVal;
-}
-
-// Check if buttons are pressed
-ButtonType CheckKeyEvent ()
-{
-	ButtonType retVal = EmergencyButton;
-
-	for (ButtonType key = FloorButton_F3; ((key >= LiftButton_F0) && (retVal == EmergencyButton)); key>>=1)
-	{
-		if (ReadKeyEvent(key) == Pressed)
-		{
-			retVal = key;
-		}
-	}
-	return retVal;
+	// a trip already heading there ends with closed doors
+	CancelCabinCall(floor);
+	ClearCabinIndicator(floor);
 }
 
 // Update the 7-Seg. display
 void UpdateDisplay (LiftPosType elevatorState)
 {
-	switch (elevatorState)
+	// floors, Error and Test, the in-between positions keep the display
+	if (elevatorState < FLOORS || elevatorState == LIFT_ERROR || elevatorState == LIFT_TEST)
 	{
-		case Floor0:
-		case Floor1:
-		case Floor2:
-		case Floor3:
-		case Error:
-		case Test:
-		{
-			SetDisplay(elevatorState);
-			break;
-		}
-		default:
-		{
-			break;
-		}
+		WriteDisplay(elevatorState);
 	}
 }
 
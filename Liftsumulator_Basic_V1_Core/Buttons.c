@@ -0,0 +1,75 @@
+/******************************************************************************
+* Program:   Lift simulation Basic Structure
+* Filename:  Buttons.c
+* Version:   1.0
+* Date:      16.10.2026
+*
+* Description:
+* Button input of the basic controllers, see Buttons.h.
+*
+* Required Libraries:
+* - LiftLibrary.h
+*
+*******************************************************************************/
+
+/*** INCLUDE FILES ************************************************************/
+#include "Buttons.h"
+
+
+/*******************************************************************************
+***  PUBLIC FUNCTIONS  *********************************************************
+*******************************************************************************/
+// Convert ButtonType to LiftPosType
+LiftPosType ConvertButtonTypeToLiftPosType (ButtonType button)
+{
+	LiftPosType retVal = None;
+
+	switch (button)
+	{
+		case LiftButton_F0:
+		case FloorButton_F0:
+		{
+			retVal = Floor0;
+			break;
+		}
+		case LiftButton_F1:
+		case FloorButton_F1:
+		{
+			retVal = Floor1;
+			break;
+		}
+		case LiftButton_F2:
+		case FloorButton_F2:
+		{
+			retVal = Floor2;
+			break;
+		}
+		case LiftButton_F3:
+		case FloorButton_F3:
+		{
+			retVal = Floor3;
+			break;
+		}
+		default:
+		{
+			break;
+		}
+	}
+
+	return retVal;
+}
+
+// Check if buttons are pressed
+ButtonType CheckKeyEvent (void)
+{
+	ButtonType retVal = EmergencyButton;
+
+	for (ButtonType key = FloorButton_F3; ((key >= LiftButton_F0) && (retVal == EmergencyButton)); key >>= 1)
+	{
+		if (ReadKeyEvent(key) == Pressed)
+		{
+			retVal = key;
+		}
+	}
+	return retVal;
+}
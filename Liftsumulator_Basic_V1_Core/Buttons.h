@@ -0,0 +1,35 @@
+/******************************************************************************
+* Program:   Lift simulation Basic Structure
+* Filename:  Buttons.h
+* Version:   1.0
+* Date:      16.10.2026
+*
+* Description:
+* Button input of the basic controllers: the first pressed button, cabin
+* buttons before floor buttons, and the floor it stands for. The buttons
+* are read through ReadKeyEvent() of the library, one at a time.
+*
+* Precondition:  InitializePorts() has been called
+*
+* Postcondition: -
+*
+*******************************************************************************/
+#ifndef BUTTONS_H_
+#define BUTTONS_H_
+
+/*** INCLUDE FILES ************************************************************/
+#include "LiftLibrary.h" // lift model library
+
+
+/*** OWN DEFINES **************************************************************/
+#define IS_CABIN_BUTTON(button)     ((button) < FloorButton_F0)
+
+
+/*** PUBLIC FUNCTIONS *********************************************************/
+// Convert ButtonType to LiftPosType, None for EmergencyButton
+LiftPosType ConvertButtonTypeToLiftPosType (ButtonType button);
+
+// Check if buttons are pressed, EmergencyButton if none is
+ButtonType CheckKeyEvent (void);
+
+#endif /* BUTTONS_H_ */
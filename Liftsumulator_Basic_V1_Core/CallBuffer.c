@@ -0,0 +1,102 @@
+/******************************************************************************
+* Program:   Lift simulation Basic Structure
+* Filename:  CallBuffer.c
+* Version:   1.2
+* Date:      16.10.2026
+*
+* Description:
+* Ring buffer of the floors called, see CallBuffer.h.
+*
+* Required Libraries:
+* - LiftLibrary.h
+*
+*******************************************************************************/
+
+/*** INCLUDE FILES ************************************************************/
+#include "CallBuffer.h"
+
+
+/*** GLOBAL Variablen *********************************************************/
+// ringbuffer for stored requests (floors)
+static LiftPosType  callBuffer[CALL_BUFFER_MAX];
+static uint8_t      bufferSize = 1;
+
+static uint8_t      readIndex;    // oldest request
+static uint8_t      count;        // requests stored
+
+
+/*******************************************************************************
+***  PUBLIC FUNCTIONS  *********************************************************
+*******************************************************************************/
+// Empty the buffer and set its size
+void InitializeCallBuffer (uint8_t size)
+{
+	if (size < 1)
+	{
+		size = 1;
+	}
+	if (size > CALL_BUFFER_MAX)
+	{
+		size = CALL_BUFFER_MAX;
+	}
+	bufferSize = size;
+	readIndex  = 0;
+	count      = 0;
+	for (uint8_t i = 0; i < size; i++)
+	{
+		callBuffer[i] = None;
+	}
+}
+
+// Add a Request to the circular buffer
+uint8_t AddRequestToBuffer (LiftPosType floorRequest, LiftPosType target)
+{
+	uint8_t index;
+
+	// return fail if buffer is full
+	if (count == bufferSize)
+	{
+		return BUFFER_FAIL;
+	}
+
+	// return success if requested floor is the current destination
+	// don't save request again but set the indicator
+	if (floorRequest == target)
+	{
+		return BUFFER_SUCCESS;
+	}
+
+	// the requested floor is already in the buffer, the free places are
+	// None
+	for (uint8_t i = 0; i < bufferSize; i++)
+	{
+		if (callBuffer[i] == floorRequest)
+		{
+			return BUFFER_SUCCESS;
+		}
+	}
+
+	// save request to buffer behind the last one
+	index = (readIndex + count < bufferSize) ? readIndex + count : readIndex + count - bufferSize;
+	callBuffer[index] = floorRequest;
+	count++;
+
+	return BUFFER_SUCCESS;
+}
+
+// Get a request from the circular buffer
+uint8_t GetRequestFromBuffer (LiftPosType *floorRequest)
+{
+	// return fail if no calls are in buffer
+	if (count == 0)
+	{
+		return BUFFER_FAIL;
+	}
+
+	*floorRequest = callBuffer[readIndex];
+	callBuffer[readIndex] = None;  // delete the request from the buffer
+	readIndex = (readIndex + 1 < bufferSize) ? readIndex + 1 : 0;
+	count--;
+
+	return BUFFER_SUCCESS;
+}
@@ -0,0 +1,48 @@
+/******************************************************************************
+* Program:   Lift simulation Basic Structure
+* Filename:  CallBuffer.h
+* Version:   1.2
+* Date:      16.10.2026
+*
+* Description:
+* Ring buffer of the floors called, served first in first out. A floor that
+* is already in the buffer or is the current target is not stored again,
+* but counts as stored so that its indicator is set. A call that finds the
+* buffer full is lost. The free places hold None; AufgabeB had the buffer
+* zero initialized, so a first call to Floor0 counted as stored and was
+* never served.
+*
+* The size is set at run time (InitializeCallBuffer()), up to
+* CALL_BUFFER_MAX calls.
+*
+* Precondition:  -
+*
+* Postcondition: -
+*
+*******************************************************************************/
+#ifndef CALLBUFFER_H_
+#define CALLBUFFER_H_
+
+/*** INCLUDE FILES ************************************************************/
+#include <stdint.h>
+#include "LiftLibrary.h" // lift model library
+
+
+/*** OWN DEFINES **************************************************************/
+#define CALL_BUFFER_MAX     8
+
+#define BUFFER_SUCCESS      0
+#define BUFFER_FAIL         1
+
+
+/*** PUBLIC FUNCTIONS *********************************************************/
+// Empty the buffer and set its size (1..CALL_BUFFER_MAX)
+void InitializeCallBuffer (uint8_t size);
+
+// Add a requested floor to the buffer
+uint8_t AddRequestToBuffer (LiftPosType floorRequest, LiftPosType target);
+
+// Get a request from the buffer if there is one
+uint8_t GetRequestFromBuffer (LiftPosType *floorRequest);
+
+#endif /* CALLBUFFER_H_ */
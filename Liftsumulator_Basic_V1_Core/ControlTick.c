@@ -0,0 +1,218 @@
+/******************************************************************************
+* Program:   Lift simulation Basic Structure
+* Filename:  ControlTick.c
+* Version:   1.2
+* Date:      16.10.2026
+*
+* Description:
+* Timer1 control tick, button change detection and tick jitter
+* measurement, see ControlTick.h.
+*
+* Required Libraries:
+* - avr/io.h, avr/interrupt.h
+*
+*******************************************************************************/
+
+/*** INCLUDE FILES ************************************************************/
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "ControlTick.h"
+#include "Keys.h"
+
+#ifdef LIFT_SIM
+#include <stdio.h>
+#include <stdlib.h>
+#include "LiftSim.h"     // host simulation runtime (event queue)
+#endif
+
+
+/*** OWN DEFINES **************************************************************/
+#define FALSE               0
+#define TRUE                1
+#define TICK_PRESCALER      CONTROL_TIME_CYCLES
+#define TICK_TOP            (F_CPU / TICK_PRESCALER / CONTROL_TICK_HZ - 1)
+#define COUNTS_PER_US       (F_CPU / TICK_PRESCALER / 1000000UL)
+
+
+/*** GLOBAL Variablen *********************************************************/
+static volatile uint8_t   pendingTicks;
+static volatile uint32_t  controlTicks;
+
+// set by the tick interrupt when the debouncer reported a button event
+static volatile uint8_t   keyEvent = FALSE;
+
+static ControlTickStatsType stats = { 0, 0, UINT16_MAX, 0, 0 };
+
+#ifdef LIFT_SIM
+static uint32_t repeatedTicks;
+static uint16_t lastLatency;     // of the last tick taken, the replayed ones alike
+#endif
+
+
+/*******************************************************************************
+***  INTERRUPTS  ***************************************************************
+*******************************************************************************/
+// Control tick
+ISR(TIMER1_COMPA_vect)
+{
+	controlTicks++;
+	if (pendingTicks < UINT8_MAX)
+	{
+		pendingTicks++;
+	}
+
+	if (SampleKeys())
+	{
+		keyEvent = TRUE;
+	}
+}
+
+
+/*******************************************************************************
+***  PRIVATE FUNCTIONS  ********************************************************
+*******************************************************************************/
+#ifdef LIFT_SIM
+// Host simulation: the same as this many compare matches in a row while the
+// buttons are settled; the main loop catches the ticks up in one go
+static void RepeatTickInterrupt (uint32_t matches)
+{
+	controlTicks  += matches;
+	repeatedTicks += matches;
+	RepeatKeySamples(matches);
+}
+
+// Host simulation: print the statistics at the end of the run
+static void ReportControlTick (void)
+{
+	fprintf(stderr, "controltick: %lu ticks, latency min/avg/max %u/%lu/%u us, %lu late\n",
+	        (unsigned long)stats.ticks, stats.ticks ? stats.latencyMin : 0,
+	        stats.ticks ? (unsigned long)(stats.latencySum / stats.ticks) : 0UL,
+	        stats.latencyMax, (unsigned long)stats.late);
+}
+#endif
+
+
+/*******************************************************************************
+***  PUBLIC FUNCTIONS  *********************************************************
+*******************************************************************************/
+// Start Timer1
+void InitializeControlTick (void)
+{
+	// CTC mode with OCR1A as TOP, F_CPU / 8 / (TICK_TOP + 1) = CONTROL_TICK_HZ
+	OCR1A  = TICK_TOP;
+	TCCR1A = 0;
+	TCCR1B = (1 << WGM12) | (1 << CS11);
+	TIMSK |= (1 << OCIE1A);
+
+#ifdef LIFT_SIM
+	LiftSimRepeatInterrupt(RepeatTickInterrupt);
+	atexit(ReportControlTick);
+#endif
+}
+
+// Is a tick waiting for the main loop?
+uint8_t ControlTickPending (void)
+{
+	return pendingTicks != 0;
+}
+
+// Number of ticks since the last call
+uint8_t TakeControlTicks (void)
+{
+	uint8_t  ticks;
+	uint16_t latency;
+
+	cli();
+	ticks        = pendingTicks;
+	pendingTicks = 0;
+	latency      = TCNT1 / COUNTS_PER_US;
+	sei();
+
+	if (ticks > 0)
+	{
+		stats.ticks      += ticks;
+		stats.late       += ticks - 1;  // including the ones not caught up
+		stats.latencySum += latency;
+		if (latency < stats.latencyMin)
+		{
+			stats.latencyMin = latency;
+		}
+		if (latency > stats.latencyMax)
+		{
+			stats.latencyMax = latency;
+		}
+#ifdef LIFT_SIM
+		lastLatency = latency;
+#endif
+	}
+	return (ticks < CONTROL_CATCH_UP_MAX) ? ticks : CONTROL_CATCH_UP_MAX;
+}
+
+// Forget the pending ticks
+void DropControlTicks (void)
+{
+	pendingTicks = 0;
+#ifdef LIFT_SIM
+	repeatedTicks = 0;
+#endif
+}
+
+#ifdef LIFT_SIM
+// Ticks the simulation replayed since the last call
+uint32_t TakeRepeatedTicks (void)
+{
+	uint32_t ticks = repeatedTicks;
+
+	repeatedTicks     = 0;
+	stats.ticks      += ticks;
+	stats.latencySum += ticks * lastLatency;
+	return ticks;
+}
+#endif
+
+// Ticks since start
+uint32_t GetControlTicks (void)
+{
+	uint32_t ticks;
+
+	cli();
+	ticks = controlTicks;
+	sei();
+	return ticks;
+}
+
+// Time since start in Timer1 counts
+uint32_t GetControlTime (void)
+{
+	uint32_t ticks;
+	uint16_t count;
+
+	cli();
+	ticks = controlTicks;
+	count = TCNT1;
+	if ((TIFR & (1 << OCF1A)) && count < TICK_TOP / 2)
+	{
+		// the counter wrapped, the interrupt is not serviced yet
+		ticks++;
+	}
+	sei();
+	return ticks * (TICK_TOP + 1) + count;
+}
+
+// Button change since ClearKeyEvent()?
+uint8_t KeyEventPending (void)
+{
+	return keyEvent;
+}
+
+// Forget old button changes
+void ClearKeyEvent (void)
+{
+	keyEvent = FALSE;
+}
+
+// Jitter and catch-up statistics
+const ControlTickStatsType *GetControlTickStats (void)
+{
+	return &stats;
+}
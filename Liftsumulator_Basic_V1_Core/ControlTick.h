@@ -0,0 +1,102 @@
+/******************************************************************************
+* Program:   Lift simulation Basic Structure
+* Filename:  ControlTick.h
+* Version:   1.4
+* Date:      16.10.2026
+*
+* Description:
+* Fixed rate control tick. Timer1 raises a compare interrupt CONTROL_TICK_HZ
+* times per second; the main loop does one control step per tick, so cabin
+* speed and door timing no longer depend on how long a loop pass takes.
+* The library paces doors and cabin by the number of SetOutput() and
+* MoveElevator() calls, so every tick calls them a fixed number of times.
+* A group controller (Group.h) makes the same calls for every car, so the
+* doors and cabins of a group move like a single car; the host simulation
+* charges the library cycles of the other cars apart (LiftSim.h).
+*
+* The ISR also samples the buttons for the debouncer (Keys.h; the ATmega32
+* has no pin change interrupts on PORTD) and flags every button event.
+*
+* The delay between a compare match and the main loop picking up the tick
+* is measured with TCNT1 (jitter); ticks the loop was too late for are
+* counted and caught up, at most CONTROL_CATCH_UP_MAX in one pass. A pass
+* that makes the library calls of more ticks only gets longer and misses
+* more ticks; beyond the limit the lift runs slower instead, and a long
+* stall ends in the watchdog reset (Fault.h), not in the catch-up.
+*
+* Precondition:  -
+*
+* Postcondition: -
+*
+*******************************************************************************/
+#ifndef CONTROLTICK_H_
+#define CONTROLTICK_H_
+
+/*** INCLUDE FILES ************************************************************/
+#include <stdint.h>
+
+
+/*** OWN DEFINES **************************************************************/
+#ifndef F_CPU
+#define F_CPU               8000000UL
+#endif
+
+#define CONTROL_TICK_HZ     1000
+#define CONTROL_CATCH_UP_MAX 4    // ticks one pass makes up for
+#define CONTROL_TIME_CYCLES 8     // Timer1 prescaler
+
+// library calls per tick and car: a door step takes 5000 SetOutput() calls
+// (250 ms), a cabin position takes speed + 2 MoveElevator() calls (Fast:
+// 50 ms, Slow: 200 ms)
+#define OUTPUTS_PER_TICK    20
+#define MOVES_PER_TICK      20
+#define CALIBRATIONS_PER_TICK 20
+
+
+/*** OWN DATA TYPES ***********************************************************/
+typedef struct
+{
+	uint32_t  ticks;        // ticks that reached the main loop
+	uint32_t  late;         // ticks caught up or beyond the catch-up limit
+	uint16_t  latencyMin;   // compare match to main loop [us]
+	uint16_t  latencyMax;
+	uint32_t  latencySum;
+} ControlTickStatsType;
+
+
+/*** PUBLIC FUNCTIONS *********************************************************/
+// Start Timer1 (interrupts are enabled by InitializePowerSave)
+void InitializeControlTick (void);
+
+// Is a tick waiting for the main loop? Call with interrupts disabled.
+uint8_t ControlTickPending (void);
+
+// Number of ticks since the last call (0 = none, at most
+// CONTROL_CATCH_UP_MAX), updates the statistics
+uint8_t TakeControlTicks (void);
+
+// Forget the pending ticks without counting them (sleeping while idle)
+void DropControlTicks (void);
+
+#ifdef LIFT_SIM
+// Host simulation: ticks the simulation replayed without the main loop since
+// the last call (LiftSimRepeat()), they count as ticks that reached it
+uint32_t TakeRepeatedTicks (void);
+#endif
+
+// Ticks since start
+uint32_t GetControlTicks (void);
+
+// Time since start in Timer1 counts (CONTROL_TIME_CYCLES CPU cycles each)
+uint32_t GetControlTime (void);
+
+// Button event since ClearKeyEvent()? Call with interrupts disabled.
+uint8_t KeyEventPending (void);
+
+// Forget old button changes, call right before the buttons are read
+void ClearKeyEvent (void);
+
+// Jitter and catch-up statistics
+const ControlTickStatsType *GetControlTickStats (void);
+
+#endif /* CONTROLTICK_H_ */
@@ -0,0 +1,233 @@
+/******************************************************************************
+* Program:   Lift simulation Basic Structure
+* Filename:  Controller.c
+* Version:   1.2
+* Date:      16.10.2026
+*
+* Description:
+* Basic lift controller, see Controller.h.
+*
+* Required Libraries:
+* - LiftLibrary.h
+* - Buttons.h
+* - Display.h
+* - CallBuffer.h
+*
+*******************************************************************************/
+
+/*** INCLUDE FILES ************************************************************/
+#include "Controller.h"
+#include "Buttons.h"     // button input
+#include "Display.h"     // 7-Seg. display
+#include "CallBuffer.h"  // stored calls
+
+
+/*** OWN DEFINES **************************************************************/
+#define FALSE               0
+#define TRUE                1
+
+
+/*** GLOBAL Variablen *********************************************************/
+static StateMachineType  state = Uninitialized;
+static LiftPosType       requestedElevatorPosition = None;
+static LiftPosType       currentElevatorState = None;
+static DirectionType     elevatorDirection = Down;
+
+
+/*******************************************************************************
+***  PRIVATE FUNCTIONS  ********************************************************
+*******************************************************************************/
+// Set the call indicator of the button
+static void SetIndicator (ButtonType key, LiftPosType floor)
+{
+	if (IS_CABIN_BUTTON(key))
+	{
+		SetIndicatorElevatorState(floor);
+	}
+	else
+	{
+		SetIndicatorFloorState(floor);
+	}
+}
+
+// Store the call of a pressed button in the call buffer
+static void StoreKey (void)
+{
+	ButtonType  key = CheckKeyEvent();
+	LiftPosType pressedFloor = ConvertButtonTypeToLiftPosType(key);
+
+	// a floor request that is not the current floor
+	if (pressedFloor <= Floor3 && pressedFloor != currentElevatorState)
+	{
+		// if call is saved to buffer, set indicators
+		if (AddRequestToBuffer(pressedFloor, requestedElevatorPosition) == BUFFER_SUCCESS)
+		{
+			SetIndicator(key, pressedFloor);
+		}
+	}
+}
+
+// Next target: from the call buffer or the button pressed now
+static uint8_t TakeCall (const ControllerConfigType *config)
+{
+	ButtonType  key;
+	LiftPosType floor;
+
+	if (config->callBuffer > 0)
+	{
+		if (GetRequestFromBuffer(&floor) != BUFFER_SUCCESS)
+		{
+			return FALSE;
+		}
+	}
+	else
+	{
+		key   = CheckKeyEvent();
+		floor = ConvertButtonTypeToLiftPosType(key);
+		if (floor == None || floor == currentElevatorState)
+		{
+			return FALSE;
+		}
+		SetIndicator(key, floor);
+	}
+
+	requestedElevatorPosition = floor;
+	elevatorDirection = requestedElevatorPosition > currentElevatorState;
+	return TRUE;
+}
+
+// Display, cabin position and outputs, done on every pass
+static void Refresh (const ControllerConfigType *config)
+{
+	UpdateDisplay(currentElevatorState);  // Update the 7-Seg. display (lift)
+	if (config->stage == StageFull)
+	{
+		currentElevatorState = ReadElevatorState();
+	}
+	SetOutput();               // Send the calculated output values to the ports
+}
+
+// One pass of the state machine
+static void RunStateMachine (const ControllerConfigType *config)
+{
+	// the skeleton's states are still empty
+	if (config->stage == StageSkeleton)
+	{
+		return;
+	}
+
+	switch (state)
+	{
+		case Uninitialized:
+		{
+			// Lift position calibration to ground floor (Floor0)
+			if (ReadElevatorState() != Floor0)
+			{
+				CalibrateElevatorPosition();
+			}
+			else
+			{
+				state = (config->stage == StageFull) ? OpenDoor : Waiting;
+				currentElevatorState = ReadElevatorState();
+			}
+			break;
+		}
+
+
+		case Waiting:
+		{
+			// Waiting for new floor request
+			if (config->stage == StageFull && TakeCall(config))
+			{
+				state = CloseDoor;
+			}
+			break;
+		}
+
+
+		case CloseDoor:
+		{
+			// Close the door and wait until the door is closed
+			if (ReadDoorState(currentElevatorState) != Closed)
+			{
+				SetDoorState(Closed, currentElevatorState);
+			}
+			else
+			{
+				state = MoveLift;
+			}
+			break;
+		}
+
+
+		case MoveLift:
+		{
+			// Move cabin to the requested floor
+			if (currentElevatorState != requestedElevatorPosition)
+			{
+				MoveElevator(elevatorDirection, config->speed);
+			}
+			else
+			{
+				state = OpenDoor;
+			}
+			break;
+		}
+
+
+		case OpenDoor:
+		{
+			// Open the door and wait still the door is open completely
+			SetDoorState(Open, currentElevatorState);
+			if (ReadDoorState(currentElevatorState) == Open)
+			{
+				state = Waiting;
+				ClrIndicatorFloorState(currentElevatorState);
+				ClrIndicatorElevatorState(currentElevatorState);
+			}
+			break;
+		}
+
+
+		case Trouble:
+		{
+			// Fault condition is not treated
+			break;
+		}
+	}
+}
+
+
+/*******************************************************************************
+***  PUBLIC FUNCTIONS  *********************************************************
+*******************************************************************************/
+// Initialize the ports and run the controller in an endless loop
+void RunController (const ControllerConfigType *config)
+{
+	InitializePorts();  // Initialization of ports
+	InitializeStart();  // Set start state of the system
+	InitializeCallBuffer(config->callBuffer);
+
+	// refreshed first: the passes are the same, but the first one starts
+	// with the refresh
+	if (config->refreshFirst)
+	{
+		Refresh(config);
+	}
+
+	// Endless loop
+	while (1)
+	{
+		// Handling state machine
+		RunStateMachine(config);
+
+		// do always
+		Refresh(config);
+
+		// with a call buffer the buttons count in every state
+		if (config->callBuffer > 0)
+		{
+			StoreKey();
+		}
+	}
+}
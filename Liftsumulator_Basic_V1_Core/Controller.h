@@ -0,0 +1,56 @@
+/******************************************************************************
+* Program:   Lift simulation Basic Structure
+* Filename:  Controller.h
+* Version:   1.2
+* Date:      16.10.2026
+*
+* Description:
+* Basic lift controller: calibration to Floor0, then one call after the
+* other with the doors closed for the trip and opened at the floor. The
+* variants of the controller only differ in their configuration:
+* - stage: how far the controller is worked out. StageSkeleton runs the
+*   empty state machine (Template, AufgabeD), StageCalibrate calibrates to
+*   Floor0 and then waits without taking calls (Working), StageFull is the
+*   whole controller. Before StageFull the cabin position is only read
+*   for the calibration.
+* - callBuffer 0: a button is only taken while the lift waits, the one
+*   pressed at that moment is the next target (AufgabeA)
+* - callBuffer n: the buttons are read on every loop pass and up to n
+*   calls are kept in the call buffer (CallBuffer.h, AufgabeB)
+* - refreshFirst: a loop pass refreshes the display and the outputs before
+*   the state machine instead of after it (AufgabeA)
+*
+* Precondition:  -
+*
+* Postcondition: never returns
+*
+*******************************************************************************/
+#ifndef CONTROLLER_H_
+#define CONTROLLER_H_
+
+/*** INCLUDE FILES ************************************************************/
+#include <stdint.h>
+#include "LiftLibrary.h" // lift model library
+
+
+/*** OWN DATA TYPES ***********************************************************/
+typedef enum {Uninitialized = 0, Waiting, CloseDoor, MoveLift, OpenDoor, Trouble}
+StateMachineType;
+
+typedef enum {StageSkeleton = 0, StageCalibrate, StageFull}
+ControllerStageType;
+
+typedef struct
+{
+	ControllerStageType  stage;          // how far the controller is worked out
+	uint8_t              callBuffer;     // calls stored, 0 = no call buffer
+	SpeedType            speed;          // speed of a trip
+	uint8_t              refreshFirst;   // outputs before the state machine
+} ControllerConfigType;
+
+
+/*** PUBLIC FUNCTIONS *********************************************************/
+// Initialize the ports and run the controller in an endless loop
+void RunController (const ControllerConfigType *config);
+
+#endif /* CONTROLLER_H_ */
@@ -0,0 +1,320 @@
+/******************************************************************************
+* Program:   Lift simulation Basic Structure
+* Filename:  Dispatcher.c
+* Version:   1.7
+* Date:      16.10.2026
+*
+* Description:
+* Call sets and dispatch policies, see Dispatcher.h. Every car of the
+* group (Group.h) has a call set of its own.
+*
+* Required Libraries:
+* - LiftLibrary.h
+* - Group.h
+*
+*******************************************************************************/
+
+/*** INCLUDE FILES ************************************************************/
+#include "Dispatcher.h"
+#include "Group.h"       // currentCar
+
+
+/*** OWN DEFINES **************************************************************/
+#define ALL_FLOORS          ((CallMaskType)(FLOOR_BIT(FLOORS - 1) * 2 - 1))
+#define TOP_FLOOR           ((LiftPosType)(FLOORS - 1))
+
+
+/*** OWN DATA TYPES ***********************************************************/
+// pending calls of one car
+typedef struct
+{
+	CallMaskType  cabin;
+	CallMaskType  hallUp;
+	CallMaskType  hallDown;
+#if DISPATCH_POLICY == DISPATCH_FIFO
+	LiftPosType   order[FLOORS];   // floors in the order they were called
+	uint8_t       count;
+#endif
+} CallSetType;
+
+
+/*** GLOBAL Variablen *********************************************************/
+static CallSetType  callSets[CARS];
+
+
+/*******************************************************************************
+***  PRIVATE FUNCTIONS  ********************************************************
+*******************************************************************************/
+// FIFO: drop a floor from the arrival order once it has no call left
+static void RemoveFromOrder (LiftPosType floor)
+{
+#if DISPATCH_POLICY == DISPATCH_FIFO
+	CallSetType *calls = &callSets[currentCar];
+	uint8_t     kept = 0;
+
+	if (IsCalled(floor))
+	{
+		return;
+	}
+	for (uint8_t i = 0; i < calls->count; i++)
+	{
+		if (calls->order[i] != floor)
+		{
+			calls->order[kept++] = calls->order[i];
+		}
+	}
+	calls->count = kept;
+#else
+	(void)floor;
+#endif
+}
+
+#if DISPATCH_POLICY != DISPATCH_FIFO
+// Floors above / below floor
+static CallMaskType FloorsAbove (LiftPosType floor)
+{
+	// FLOOR_BIT(FLOORS) would shift by the width of the mask at 8, 16, 32
+	// or 64 floors
+	if (floor >= FLOORS - 1)
+	{
+		return 0;
+	}
+	return ALL_FLOORS & ~(FLOOR_BIT(floor + 1) - 1);
+}
+
+static CallMaskType FloorsBelow (LiftPosType floor)
+{
+	return FLOOR_BIT(floor) - 1;
+}
+#endif
+
+#if DISPATCH_POLICY == DISPATCH_SCAN || DISPATCH_POLICY == DISPATCH_LOOK
+// Next stop beyond floor in the given direction, LIFT_NONE if there is none:
+// cabin calls and hall calls in the same direction first, otherwise the
+// farthest hall call against it, where the cabin turns
+static LiftPosType NextStopAhead (LiftPosType floor, DirectionType direction)
+{
+	CallSetType  *calls = &callSets[currentCar];
+	CallMaskType along;
+	CallMaskType turn;
+
+	if (direction == Up)
+	{
+		along = (calls->cabin | calls->hallUp) & FloorsAbove(floor);
+		turn  = calls->hallDown & FloorsAbove(floor);
+		return along ? LOWEST_FLOOR(along) : (turn ? HIGHEST_FLOOR(turn) : LIFT_NONE);
+	}
+
+	along = (calls->cabin | calls->hallDown) & FloorsBelow(floor);
+	turn  = calls->hallUp & FloorsBelow(floor);
+	return along ? HIGHEST_FLOOR(along) : (turn ? LOWEST_FLOOR(turn) : LIFT_NONE);
+}
+#endif
+
+#if DISPATCH_POLICY == DISPATCH_SSTF
+// Nearest call in either direction, ties go the current direction
+static LiftPosType NearestCall (LiftPosType floor, DirectionType direction)
+{
+	CallSetType  *calls  = &callSets[currentCar];
+	CallMaskType pending = calls->cabin | calls->hallUp | calls->hallDown;
+	CallMaskType above   = pending & FloorsAbove(floor);
+	CallMaskType below   = pending & FloorsBelow(floor);
+	LiftPosType  up      = above ? LOWEST_FLOOR(above) : LIFT_NONE;
+	LiftPosType  down    = below ? HIGHEST_FLOOR(below) : LIFT_NONE;
+
+	if (pending & FLOOR_BIT(floor))
+	{
+		return floor;
+	}
+	if (up == LIFT_NONE)
+	{
+		return down;
+	}
+	if (down == LIFT_NONE)
+	{
+		return up;
+	}
+	if (up - floor == floor - down)
+	{
+		return (direction == Up) ? up : down;
+	}
+	return (up - floor < floor - down) ? up : down;
+}
+#endif
+
+
+/*******************************************************************************
+***  PUBLIC FUNCTIONS  *********************************************************
+*******************************************************************************/
+// Store a call
+void AddCall (LiftPosType floor, CallType type)
+{
+	CallSetType *calls = &callSets[currentCar];
+
+	if (floor >= FLOORS)
+	{
+		return;
+	}
+
+#if DISPATCH_POLICY == DISPATCH_FIFO
+	if (!IsCalled(floor))
+	{
+		calls->order[calls->count++] = floor;
+	}
+#endif
+
+	if (type == CabinCall)
+	{
+		calls->cabin |= FLOOR_BIT(floor);
+	}
+	else
+	{
+		if (floor != TOP_FLOOR)
+		{
+			calls->hallUp |= FLOOR_BIT(floor);
+		}
+		if (floor != Floor0)
+		{
+			calls->hallDown |= FLOOR_BIT(floor);
+		}
+	}
+}
+
+// Remove the calls of a floor
+void ClearCall (LiftPosType floor)
+{
+	CallSetType *calls = &callSets[currentCar];
+
+	if (floor >= FLOORS)
+	{
+		return;
+	}
+
+	calls->cabin    &= ~FLOOR_BIT(floor);
+	calls->hallUp   &= ~FLOOR_BIT(floor);
+	calls->hallDown &= ~FLOOR_BIT(floor);
+	RemoveFromOrder(floor);
+}
+
+// Remove only the cabin call of a floor
+void CancelCabinCall (LiftPosType floor)
+{
+	CallSetType *calls = &callSets[currentCar];
+
+	if (floor >= FLOORS)
+	{
+		return;
+	}
+
+	calls->cabin &= ~FLOOR_BIT(floor);
+	RemoveFromOrder(floor);
+}
+
+// Remove only the hall call of a floor
+void CancelHallCall (LiftPosType floor)
+{
+	CallSetType *calls = &callSets[currentCar];
+
+	if (floor >= FLOORS)
+	{
+		return;
+	}
+
+	calls->hallUp   &= ~FLOOR_BIT(floor);
+	calls->hallDown &= ~FLOOR_BIT(floor);
+	RemoveFromOrder(floor);
+}
+
+// Is there a call for this floor?
+uint8_t IsCalled (LiftPosType floor)
+{
+	CallSetType *calls = &callSets[currentCar];
+
+	return (floor < FLOORS) && ((calls->cabin | calls->hallUp | calls->hallDown) & FLOOR_BIT(floor));
+}
+
+// Next floor to go to
+LiftPosType GetNextTarget (LiftPosType currentFloor, DirectionType direction)
+{
+	CallSetType *calls = &callSets[currentCar];
+	LiftPosType target;
+
+	if (!(calls->cabin | calls->hallUp | calls->hallDown))
+	{
+		return LIFT_NONE;
+	}
+
+#if DISPATCH_POLICY == DISPATCH_FIFO
+	(void)direction;
+	target = calls->order[0];
+
+#elif DISPATCH_POLICY == DISPATCH_SCAN
+	// keep going to the end of the shaft, then turn
+	target = IsCalled(currentFloor) ? currentFloor : NextStopAhead(currentFloor, direction);
+	if (target == LIFT_NONE)
+	{
+		LiftPosType end = (direction == Up) ? TOP_FLOOR : Floor0;
+		target = (currentFloor != end) ? end : NextStopAhead(currentFloor, !direction);
+	}
+
+#elif DISPATCH_POLICY == DISPATCH_LOOK
+	// turn as soon as there is no call ahead
+	target = IsCalled(currentFloor) ? currentFloor : NextStopAhead(currentFloor, direction);
+	if (target == LIFT_NONE)
+	{
+		target = NextStopAhead(currentFloor, !direction);
+	}
+
+#elif DISPATCH_POLICY == DISPATCH_SSTF
+	target = NearestCall(currentFloor, direction);
+
+#else
+#error "DISPATCH_POLICY must be DISPATCH_FIFO, DISPATCH_SCAN, DISPATCH_LOOK or DISPATCH_SSTF"
+#endif
+
+	return target;
+}
+
+// Nearest called floor on the way to target
+LiftPosType GetStopOnTheWay (LiftPosType floor, LiftPosType target, DirectionType direction)
+{
+#if DISPATCH_POLICY == DISPATCH_FIFO
+	(void)floor;
+	(void)target;
+	(void)direction;
+	return LIFT_NONE;
+#else
+	CallSetType  *calls = &callSets[currentCar];
+	CallMaskType between;
+	CallMaskType stops;
+
+	if (floor >= FLOORS || target >= FLOORS)
+	{
+		return LIFT_NONE;
+	}
+
+#if DISPATCH_POLICY == DISPATCH_SSTF
+	// SSTF would pick any nearer call at the next stop
+	stops = calls->cabin | calls->hallUp | calls->hallDown;
+#else
+	// SCAN and LOOK take the calls in the direction of travel
+	stops = calls->cabin | ((direction == Up) ? calls->hallUp : calls->hallDown);
+#endif
+
+	if (direction == Up)
+	{
+		between = stops & FloorsAbove(floor) & FloorsBelow(target);
+		return between ? LOWEST_FLOOR(between) : LIFT_NONE;
+	}
+	between = stops & FloorsBelow(floor) & FloorsAbove(target);
+	return between ? HIGHEST_FLOOR(between) : LIFT_NONE;
+#endif
+}
+
+// Calls of a car by type, hall calls of both directions together
+CallMaskType GetCarCalls (uint8_t car, CallType type)
+{
+	CallSetType *calls = &callSets[car];
+
+	return (type == CabinCall) ? calls->cabin : (calls->hallUp | calls->hallDown);
+}
@@ -0,0 +1,117 @@
+/******************************************************************************
+* Program:   Lift simulation Basic Structure
+* Filename:  Dispatcher.h
+* Version:   1.6
+* Date:      16.10.2026
+*
+* Description:
+* Pending calls and the choice of the next target floor. The policy is
+* selected at build time with DISPATCH_POLICY:
+* - DISPATCH_FIFO  calls in the order they were made
+* - DISPATCH_SCAN  nearest call in the direction of travel, then on to the
+*                  end of the shaft before turning
+* - DISPATCH_LOOK  nearest call in the direction of travel, turns as soon
+*                  as there is none ahead (default)
+* - DISPATCH_SSTF  nearest call in either direction
+* SCAN, LOOK and SSTF pick a new target at every stop, so floors with calls
+* on the way are served before the farther ones. A call made while the
+* cabin is already on its way is found at the next floor it passes
+* (GetStopOnTheWay()); FIFO keeps its order and does not stop on the way.
+*
+* The calls are kept as bit sets with one bit per floor: cabin calls, hall
+* calls upwards and hall calls downwards. Storing, clearing and testing a
+* call is a single bit operation, the nearest call in a direction is found
+* with a find-first-set on the masked set.
+*
+* The calls are kept per car; the functions work on the car selected with
+* SelectCar() (Group.h).
+*
+* Precondition:  -
+*
+* Postcondition: -
+*
+*******************************************************************************/
+#ifndef DISPATCHER_H_
+#define DISPATCHER_H_
+
+/*** INCLUDE FILES ************************************************************/
+#include <stdint.h>
+#include "LiftLibrary.h" // lift model library
+#include "LiftConfig.h"  // LIFT_FLOORS
+
+
+/*** OWN DEFINES **************************************************************/
+#define FLOORS              LIFT_FLOORS
+
+#define DISPATCH_FIFO       0
+#define DISPATCH_SCAN       1
+#define DISPATCH_LOOK       2
+#define DISPATCH_SSTF       3
+
+#ifndef DISPATCH_POLICY
+#define DISPATCH_POLICY     DISPATCH_LOOK
+#endif
+
+
+/*** OWN DATA TYPES ***********************************************************/
+// one bit per floor, bit 0 = Floor0
+#if FLOORS <= 8
+typedef uint8_t   CallMaskType;
+#elif FLOORS <= 16
+typedef uint16_t  CallMaskType;
+#elif FLOORS <= 32
+typedef uint32_t  CallMaskType;
+#else
+typedef uint64_t  CallMaskType;
+#endif
+
+#define FLOOR_BIT(floor)    ((CallMaskType)1 << (floor))
+
+// find first / last set bit of a non-empty mask, number of set bits
+#if FLOORS <= 16
+#define LOWEST_FLOOR(mask)  ((LiftPosType)__builtin_ctz(mask))
+#define HIGHEST_FLOOR(mask) ((LiftPosType)(sizeof(int) * 8 - 1 - __builtin_clz(mask)))
+#define FLOOR_COUNT(mask)   ((uint8_t)__builtin_popcount(mask))
+#elif FLOORS <= 32
+#define LOWEST_FLOOR(mask)  ((LiftPosType)__builtin_ctzl(mask))
+#define HIGHEST_FLOOR(mask) ((LiftPosType)(sizeof(long) * 8 - 1 - __builtin_clzl(mask)))
+#define FLOOR_COUNT(mask)   ((uint8_t)__builtin_popcountl(mask))
+#else
+#define LOWEST_FLOOR(mask)  ((LiftPosType)__builtin_ctzll(mask))
+#define HIGHEST_FLOOR(mask) ((LiftPosType)(sizeof(long long) * 8 - 1 - __builtin_clzll(mask)))
+#define FLOOR_COUNT(mask)   ((uint8_t)__builtin_popcountll(mask))
+#endif
+
+// the floor panels have one button; it calls in both directions except
+// at the end floors
+typedef enum {CabinCall = 0, HallCall}
+CallType;
+
+
+/*** PUBLIC FUNCTIONS *********************************************************/
+// Store a call, a floor that is already called is stored only once
+void AddCall (LiftPosType floor, CallType type);
+
+// Remove the calls of a floor (doors opened there)
+void ClearCall (LiftPosType floor);
+
+// Remove only the cabin call of a floor (cancelled by a long press)
+void CancelCabinCall (LiftPosType floor);
+
+// Remove only the hall call of a floor (handed to another car)
+void CancelHallCall (LiftPosType floor);
+
+// Is there a call for this floor?
+uint8_t IsCalled (LiftPosType floor);
+
+// Next floor to go to from currentFloor, LIFT_NONE if there are no calls
+LiftPosType GetNextTarget (LiftPosType currentFloor, DirectionType direction);
+
+// Nearest called floor between floor and target (both excluded) the policy
+// stops at on a trip in direction, LIFT_NONE if there is none
+LiftPosType GetStopOnTheWay (LiftPosType floor, LiftPosType target, DirectionType direction);
+
+// Calls of any car by type (group dispatcher)
+CallMaskType GetCarCalls (uint8_t car, CallType type);
+
+#endif /* DISPATCHER_H_ */
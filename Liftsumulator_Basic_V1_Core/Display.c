@@ -0,0 +1,42 @@
+/******************************************************************************
+* Program:   Lift simulation Basic Structure
+* Filename:  Display.c
+* Version:   1.0
+* Date:      16.10.2026
+*
+* Description:
+* 7-segment display of the basic controllers, see Display.h.
+*
+* Required Libraries:
+* - LiftLibrary.h
+*
+*******************************************************************************/
+
+/*** INCLUDE FILES ************************************************************/
+#include "Display.h"
+
+
+/*******************************************************************************
+***  PUBLIC FUNCTIONS  *********************************************************
+*******************************************************************************/
+// Update the 7-Seg. display
+void UpdateDisplay (LiftPosType elevatorState)
+{
+	switch (elevatorState)
+	{
+		case Floor0:
+		case Floor1:
+		case Floor2:
+		case Floor3:
+		case Error:
+		case Test:
+		{
+			SetDisplay(elevatorState);
+			break;
+		}
+		default:
+		{
+			break;
+		}
+	}
+}
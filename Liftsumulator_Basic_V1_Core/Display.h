@@ -0,0 +1,27 @@
+/******************************************************************************
+* Program:   Lift simulation Basic Structure
+* Filename:  Display.h
+* Version:   1.0
+* Date:      16.10.2026
+*
+* Description:
+* 7-segment display of the basic controllers. It shows the floors, Error
+* and Test; between two floors it keeps the last floor.
+*
+* Precondition:  InitializePorts() has been called
+*
+* Postcondition: -
+*
+*******************************************************************************/
+#ifndef DISPLAY_H_
+#define DISPLAY_H_
+
+/*** INCLUDE FILES ************************************************************/
+#include "LiftLibrary.h" // lift model library
+
+
+/*** PUBLIC FUNCTIONS *********************************************************/
+// Update the 7-Seg. display
+void UpdateDisplay (LiftPosType elevatorState);
+
+#endif /* DISPLAY_H_ */
@@ -0,0 +1,151 @@
+/******************************************************************************
+* Program:   Lift simulation Basic Structure
+* Filename:  Group.c
+* Version:   1.3
+* Date:      16.10.2026
+*
+* Description:
+* Car contexts and hall call assignment of the group, see Group.h.
+*
+* Required Libraries:
+* - LiftLibrary.h
+* - Dispatcher.h
+*
+*******************************************************************************/
+
+/*** INCLUDE FILES ************************************************************/
+#include "Group.h"
+#include "Dispatcher.h"  // FLOORS, FLOOR_BIT(), GetCarCalls()
+
+
+/*** OWN DEFINES **************************************************************/
+#define DISTANCE(a, b)      (((a) > (b)) ? (a) - (b) : (b) - (a))
+
+
+/*** GLOBAL Variablen *********************************************************/
+CarType  cars[CARS];
+
+#if CARS > 1
+uint8_t  currentCar = 0;
+#endif
+
+
+/*******************************************************************************
+***  PRIVATE FUNCTIONS  ********************************************************
+*******************************************************************************/
+// Floors strictly between a and b
+static CallMaskType FloorsBetween (LiftPosType a, LiftPosType b)
+{
+	LiftPosType low  = (a < b) ? a : b;
+	LiftPosType high = (a < b) ? b : a;
+
+	return (FLOOR_BIT(high) - 1) & ~(FLOOR_BIT(low + 1) - 1);
+}
+
+// Estimated time [ms] until the car stops at the floor
+static uint32_t EstimateArrival (uint8_t index, LiftPosType floor)
+{
+	CarType       *car = &cars[index];
+	CallMaskType  stops = GetCarCalls(index, CabinCall) | GetCarCalls(index, HallCall);
+	LiftPosType   from = car->lastFloor;
+	LiftPosType   turn = from;
+	uint8_t       floors;
+	uint8_t       stopsBefore;
+	uint32_t      time = 0;
+
+	if (car->state == Uninitialized || from >= FLOORS)
+	{
+		// still calibrating: Floor0 first
+		from = Floor0;
+		time += GROUP_STOP_MS;
+	}
+	else if (car->state != Waiting)
+	{
+		// the stop under way has to finish
+		time += GROUP_STOP_MS / 2;
+	}
+
+	if (stops == 0 || (car->elevatorDirection == Up) == (floor >= from))
+	{
+		// on the way: the calls in between are served first
+		floors      = DISTANCE(floor, from);
+		stopsBefore = FLOOR_COUNT(stops & FloorsBetween(from, floor));
+	}
+	else
+	{
+		// behind the car: it turns at its farthest call ahead
+		for (uint8_t next = 0; next < FLOORS; next++)
+		{
+			if ((stops & FLOOR_BIT(next))
+			    && (car->elevatorDirection == Up ? next > turn : next < turn))
+			{
+				turn = (LiftPosType)next;
+			}
+		}
+		floors      = DISTANCE(turn, from) + DISTANCE(turn, floor);
+		stopsBefore = FLOOR_COUNT(stops & ~FLOOR_BIT(floor));
+	}
+
+	return time + (uint32_t)floors * GROUP_FLOOR_MS + (uint32_t)stopsBefore * GROUP_STOP_MS;
+}
+
+
+/*******************************************************************************
+***  PUBLIC FUNCTIONS  *********************************************************
+*******************************************************************************/
+// Start state of all cars
+void InitializeGroup (void)
+{
+	for (uint8_t index = 0; index < CARS; index++)
+	{
+		CarType *car = &cars[index];
+
+		car->state                     = Uninitialized;
+		car->tracedState               = Uninitialized;
+		car->requestedElevatorPosition = LIFT_NONE;
+		car->currentElevatorState      = LIFT_NONE;
+		car->lastFloor                 = LIFT_NONE;
+		car->elevatorDirection         = Down;
+	}
+}
+
+#if CARS > 1
+// Select the car the library calls and the per car data refer to
+void SelectCar (uint8_t car)
+{
+	currentCar = car;
+	LiftSelectCar(car);
+}
+#endif
+
+// Car that serves a hall call of the floor
+uint8_t AssignHallCall (LiftPosType floor)
+{
+	uint8_t  best = 0;
+	uint32_t bestTime = UINT32_MAX;
+
+	for (uint8_t index = 0; index < CARS && CARS > 1; index++)
+	{
+		uint32_t time;
+
+		// a car out of service takes no hall calls
+		if (cars[index].state == Trouble)
+		{
+			continue;
+		}
+
+		// a floor keeps the car its hall call was given to
+		if (GetCarCalls(index, HallCall) & FLOOR_BIT(floor))
+		{
+			return index;
+		}
+
+		time = EstimateArrival(index, floor);
+		if (time < bestTime)
+		{
+			best     = index;
+			bestTime = time;
+		}
+	}
+	return best;
+}
@@ -0,0 +1,98 @@
+/******************************************************************************
+* Program:   Lift simulation Basic Structure
+* Filename:  Group.h
+* Version:   1.2
+* Date:      16.10.2026
+*
+* Description:
+* Group control of CARS cars on one controller. Every car has a context
+* (CarType) with its state machine and position; the modules with per car
+* data (calls, trip profile, output shadows, buttons) keep one copy per car
+* and work on the selected one (currentCar). SelectCar() also selects the
+* car in the library, so the library calls of the main loop need no car
+* argument.
+*
+* Cabin calls go to their car. A hall call goes to the car with the lowest
+* estimated time of arrival: the floors it still has to drive, following
+* its direction of travel to the farthest call before turning, plus a stop
+* time for every call on the way. A floor that already has a hall call
+* keeps its car. A car in Trouble (Fault.h) takes no hall calls.
+*
+* The ATmega32 board drives one cabin, so CARS > 1 needs the group
+* extension of the host simulation (LiftGroup.h, up to 8 cars). With
+* CARS 1 currentCar is the constant 0 and SelectCar() compiles to nothing.
+*
+* Precondition:  InitializePorts() has been called
+*
+* Postcondition: -
+*
+*******************************************************************************/
+#ifndef GROUP_H_
+#define GROUP_H_
+
+/*** INCLUDE FILES ************************************************************/
+#include <stdint.h>
+#include "LiftLibrary.h" // lift model library
+#include "LiftConfig.h"  // LIFT_STEPS_PER_FLOOR
+
+
+/*** OWN DEFINES **************************************************************/
+#ifndef CARS
+#define CARS                1
+#endif
+
+#if CARS > 1
+#ifndef LIFT_SIM
+#error "CARS > 1 needs the group extension of the host simulation"
+#endif
+#include "LiftGroup.h"   // LiftSelectCar(), LIFT_CARS_MAX
+#if CARS > LIFT_CARS_MAX
+#error "CARS exceeds the cars of the host simulation"
+#endif
+#endif
+
+// arrival time estimate
+#define GROUP_FLOOR_MS      (LIFT_STEPS_PER_FLOOR * 50)  // one floor at cruise speed
+#define GROUP_STOP_MS       2500  // ramps and door cycle of a stop on the way
+
+
+/*** OWN DATA TYPES ***********************************************************/
+typedef enum {Uninitialized = 0, Waiting, CloseDoor, MoveLift, OpenDoor, Trouble}
+StateMachineType;
+
+typedef struct
+{
+	StateMachineType  state;
+	StateMachineType  tracedState;
+	LiftPosType       requestedElevatorPosition;
+	LiftPosType       currentElevatorState;
+	LiftPosType       lastFloor;          // last floor reached
+	DirectionType     elevatorDirection;
+} CarType;
+
+
+/*** GLOBAL Variablen *********************************************************/
+extern CarType cars[CARS];
+
+#if CARS > 1
+extern uint8_t currentCar;
+#else
+#define currentCar          0
+#endif
+
+
+/*** PUBLIC FUNCTIONS *********************************************************/
+// Start state of all cars
+void InitializeGroup (void);
+
+// Select the car the library calls and the per car data refer to
+#if CARS > 1
+void SelectCar (uint8_t car);
+#else
+#define SelectCar(car)
+#endif
+
+// Car that serves a hall call of the floor
+uint8_t AssignHallCall (LiftPosType floor);
+
+#endif /* GROUP_H_ */
@@ -0,0 +1,265 @@
+/******************************************************************************
+* Program:   Lift simulation Basic Structure
+* Filename:  InputLog.c
+* Version:   1.2
+* Date:      16.10.2026
+*
+* Description:
+* Run length coded log of the raw button inputs, see InputLog.h.
+*
+* Required Libraries:
+* - Group.h
+* - ControlTick.h
+*
+*******************************************************************************/
+
+/*** INCLUDE FILES ************************************************************/
+#include <string.h>
+#include <stddef.h>
+#include "InputLog.h"
+#include "Group.h"       // CARS
+#include "ControlTick.h" // CONTROL_TICK_HZ
+
+#ifdef LIFT_SIM
+#include <stdio.h>
+#include <stdlib.h>
+#include "LiftSim.h"     // host simulation runtime (event queue)
+#endif
+
+#if INPUT_LOG_ENABLE
+
+/*** OWN DEFINES **************************************************************/
+#define FALSE               0
+#define TRUE                1
+
+// the replay log is written by the debugger after the reset, the start-up
+// code must not clear it
+#if INPUT_LOG_ENABLE == INPUT_LOG_REPLAY && !defined(LIFT_SIM)
+#define INPUT_LOG_SECTION   __attribute__((section(".noinit")))
+#else
+#define INPUT_LOG_SECTION
+#endif
+
+
+/*** GLOBAL Variablen *********************************************************/
+InputLogType inputLog INPUT_LOG_SECTION;
+
+// ticks since the last record, buttons of every car at the last record;
+// used by the tick ISR only
+static uint16_t      run;
+static uint16_t      position;     // next record of the replay
+static CallMaskType  cabinKeys[CARS];
+static CallMaskType  floorKeys[CARS];
+
+
+/*******************************************************************************
+***  PRIVATE FUNCTIONS  ********************************************************
+*******************************************************************************/
+#if INPUT_LOG_ENABLE == INPUT_LOG_RECORD
+
+// Add a record for the buttons of a car
+static void AddRecord (uint8_t car)
+{
+	InputRecordType *record;
+
+	if (inputLog.count == INPUT_LOG_DEPTH)
+	{
+		inputLog.full = TRUE;
+		return;
+	}
+	record = &inputLog.record[inputLog.count++];
+	record->ticks = run;
+	record->car   = car;
+	record->cabin = cabinKeys[car];
+	record->floor = floorKeys[car];
+	run = 0;
+}
+
+#ifdef LIFT_SIM
+// Host simulation: save the records to $LIFTSIM_INPUT_LOG
+static void SaveInputLog (void)
+{
+	const char *name = getenv("LIFTSIM_INPUT_LOG");
+	FILE       *file;
+
+	if (!name || !*name)
+	{
+		return;
+	}
+	file = fopen(name, "wb");
+	if (!file)
+	{
+		perror(name);
+		return;
+	}
+	fwrite(&inputLog, offsetof(InputLogType, record) + inputLog.count * sizeof(InputRecordType), 1, file);
+	fclose(file);
+}
+#endif
+
+#else
+
+#ifdef LIFT_SIM
+// Host simulation: load the records from $LIFTSIM_INPUT_LOG
+static void LoadInputLog (void)
+{
+	const char *name = getenv("LIFTSIM_INPUT_LOG");
+	FILE       *file = (name && *name) ? fopen(name, "rb") : NULL;
+
+	if (!file)
+	{
+		fprintf(stderr, "inputlog: replay needs the log in LIFTSIM_INPUT_LOG\n");
+		exit(2);
+	}
+	if (fread(&inputLog, 1, sizeof(inputLog), file) < offsetof(InputLogType, record))
+	{
+		memset(&inputLog, 0, sizeof(inputLog));
+	}
+	fclose(file);
+}
+
+// Host simulation: the replayed buttons do not come from the scenario, so
+// the simulation must not skip the idle wake-ups past the tick of a record
+static void ScheduleInputLog (void)
+{
+	uint64_t start = LiftSimMicros();  // the tick timer starts right after
+	uint64_t ticks = 0;
+
+	for (uint16_t index = 0; index < inputLog.count; index++)
+	{
+		if (inputLog.record[index].ticks != 0)
+		{
+			ticks += inputLog.record[index].ticks;
+			LiftSimScheduleWakeUp(start + ticks * 1000000 / CONTROL_TICK_HZ);
+		}
+	}
+}
+#endif
+
+#endif
+
+
+/*******************************************************************************
+***  PUBLIC FUNCTIONS  *********************************************************
+*******************************************************************************/
+// Reset the log (record) or check it and start from its beginning (replay)
+void InitializeInputLog (void)
+{
+	run      = 0;
+	position = 0;
+	memset(cabinKeys, 0, sizeof(cabinKeys));
+	memset(floorKeys, 0, sizeof(floorKeys));
+
+#if INPUT_LOG_ENABLE == INPUT_LOG_RECORD
+	memcpy(inputLog.magic, INPUT_LOG_MAGIC, sizeof(inputLog.magic));
+	inputLog.floors = FLOORS;
+	inputLog.cars   = CARS;
+	inputLog.depth  = INPUT_LOG_DEPTH;
+	inputLog.count  = 0;
+	inputLog.full   = FALSE;
+
+#ifdef LIFT_SIM
+	atexit(SaveInputLog);
+#endif
+#else
+#ifdef LIFT_SIM
+	LoadInputLog();
+#endif
+	// a log of another build or no log: nothing is pressed
+	if (memcmp(inputLog.magic, INPUT_LOG_MAGIC, sizeof(inputLog.magic)) != 0
+	    || inputLog.floors != FLOORS || inputLog.cars != CARS || inputLog.count > INPUT_LOG_DEPTH)
+	{
+#ifdef LIFT_SIM
+		fprintf(stderr, "inputlog: the log does not fit this build (%u floors, %u cars)\n", FLOORS, CARS);
+		exit(2);
+#endif
+		inputLog.count = 0;
+		inputLog.full  = FALSE;
+	}
+#ifdef LIFT_SIM
+	ScheduleInputLog();
+#endif
+#endif
+}
+
+// A tick of the button scan starts
+void InputLogTick (void)
+{
+	run++;
+
+#if INPUT_LOG_ENABLE == INPUT_LOG_RECORD
+	// nothing changed for INPUT_LOG_RUN_MAX ticks
+	if (run == INPUT_LOG_RUN_MAX)
+	{
+		AddRecord(0);
+	}
+#else
+	// the records of this tick: the first one counts the ticks since the
+	// record before, the others of the same tick have 0
+	while (position < inputLog.count && inputLog.record[position].ticks == run)
+	{
+		const InputRecordType *record = &inputLog.record[position++];
+
+		cabinKeys[record->car] = record->cabin;
+		floorKeys[record->car] = record->floor;
+		run = 0;
+	}
+
+	// the recording was cut short: release everything after its end
+	if (position == inputLog.count && inputLog.full)
+	{
+		memset(cabinKeys, 0, sizeof(cabinKeys));
+		memset(floorKeys, 0, sizeof(floorKeys));
+	}
+#endif
+}
+
+// Raw buttons of a car in this tick
+void InputLogButtons (uint8_t car, CallMaskType *cabin, CallMaskType *floor)
+{
+#if INPUT_LOG_ENABLE == INPUT_LOG_RECORD
+	if (*cabin != cabinKeys[car] || *floor != floorKeys[car])
+	{
+		cabinKeys[car] = *cabin;
+		floorKeys[car] = *floor;
+		AddRecord(car);
+	}
+#else
+	*cabin = cabinKeys[car];
+	*floor = floorKeys[car];
+#endif
+}
+
+#ifdef LIFT_SIM
+// Host simulation: this many ticks in a row without a button change. No
+// replayed record is due in them, the simulation wakes up for every one.
+void InputLogRepeat (uint32_t ticks)
+{
+#if INPUT_LOG_ENABLE == INPUT_LOG_RECORD
+	while (ticks > 0)
+	{
+		// ticks before the one that records the unchanged run
+		uint32_t step = (uint16_t)(INPUT_LOG_RUN_MAX - run - 1);
+
+		if (step >= ticks)
+		{
+			run += ticks;
+			break;
+		}
+		run   += step;
+		ticks -= step;
+		InputLogTick();
+		ticks--;
+	}
+#else
+	run += ticks;
+	if (position == inputLog.count && inputLog.full)
+	{
+		memset(cabinKeys, 0, sizeof(cabinKeys));
+		memset(floorKeys, 0, sizeof(floorKeys));
+	}
+#endif
+}
+#endif
+
+#endif /* INPUT_LOG_ENABLE */
@@ -0,0 +1,124 @@
+/******************************************************************************
+* Program:   Lift simulation Basic Structure
+* Filename:  InputLog.h
+* Version:   1.2
+* Date:      16.10.2026
+*
+* Description:
+* Record and replay of the button inputs. The control tick samples the
+* raw (not debounced) buttons of every car once per tick (Keys.h); the log
+* keeps a record whenever the buttons of a car change: the ticks since the
+* record before, the car and its cabin and floor buttons as bit masks. A
+* button held for minutes is one record, ticks without a change are not
+* stored (run length coding). Ticks longer than INPUT_LOG_RUN_MAX without
+* a change are bridged by a record that repeats the buttons of car 0.
+*
+* INPUT_LOG_ENABLE selects the mode:
+*   INPUT_LOG_RECORD  the log keeps the first INPUT_LOG_DEPTH changes after
+*                     the start, later ones only set full
+*   INPUT_LOG_REPLAY  the buttons are taken from the log instead of the
+*                     pins, tick for tick from the start; after the end of
+*                     a full log all buttons are released
+*   INPUT_LOG_OFF     the calls compile to nothing
+*
+* Everything after the buttons follows from the ticks the inputs arrive
+* at, so a replay repeats the state transitions of the recorded run as
+* long as the lift (sensors, doors) behaves the same.
+*
+* On the target the log (inputLog) is saved from the debugger memory view.
+* For a replay it is written back into inputLog with the debugger after
+* the reset; the replay build keeps it in .noinit and only checks it. The
+* host simulation writes the log to the file named by LIFTSIM_INPUT_LOG at
+* the end of the run, and a replay build reads it from there and tells
+* the simulation the tick of every record, so the idle wake-ups are not
+* skipped past a replayed button change.
+*
+* Precondition:  called before InitializeControlTick()
+*
+* Postcondition: -
+*
+*******************************************************************************/
+#ifndef INPUTLOG_H_
+#define INPUTLOG_H_
+
+/*** INCLUDE FILES ************************************************************/
+#include <stdint.h>
+#include "Dispatcher.h"  // CallMaskType, FLOORS
+
+
+/*** OWN DEFINES **************************************************************/
+#define INPUT_LOG_OFF       0
+#define INPUT_LOG_RECORD    1
+#define INPUT_LOG_REPLAY    2
+
+#ifndef INPUT_LOG_ENABLE
+#define INPUT_LOG_ENABLE    INPUT_LOG_RECORD
+#endif
+
+// number of records
+#ifndef INPUT_LOG_DEPTH
+#ifdef LIFT_SIM
+#define INPUT_LOG_DEPTH     16384
+#else
+#define INPUT_LOG_DEPTH     64
+#endif
+#endif
+
+#define INPUT_LOG_MAGIC     "LIN1"
+#define INPUT_LOG_RUN_MAX   UINT16_MAX
+
+
+/*** OWN DATA TYPES ***********************************************************/
+typedef struct __attribute__((packed))
+{
+	uint16_t      ticks;   // since the record before, 0 = same tick
+	uint8_t       car;
+	CallMaskType  cabin;   // pressed buttons, one bit per floor
+	CallMaskType  floor;
+} InputRecordType;
+
+typedef struct __attribute__((packed))
+{
+	char             magic[4];
+	uint8_t          floors;  // FLOORS and CARS of the recording build
+	uint8_t          cars;
+	uint16_t         depth;
+	uint16_t         count;   // records in the log
+	uint8_t          full;    // changes after the last record were lost
+	InputRecordType  record[INPUT_LOG_DEPTH];
+} InputLogType;
+
+
+/*** PUBLIC FUNCTIONS *********************************************************/
+#if INPUT_LOG_ENABLE
+
+extern InputLogType inputLog;
+
+// Reset the log (record) or check it and start from its beginning (replay)
+void InitializeInputLog (void);
+
+// A tick of the button scan starts, called by SampleKeys()
+void InputLogTick (void);
+
+// Raw buttons of a car in this tick: kept (record) or replaced (replay)
+void InputLogButtons (uint8_t car, CallMaskType *cabin, CallMaskType *floor);
+
+#ifdef LIFT_SIM
+// Host simulation: this many ticks in a row without a button change
+void InputLogRepeat (uint32_t ticks);
+#endif
+
+#define INPUT_LOG_TICK()                    InputLogTick()
+#define INPUT_LOG_BUTTONS(car, cabin, floor) InputLogButtons(car, cabin, floor)
+#define INPUT_LOG_REPEAT(ticks)             InputLogRepeat(ticks)
+
+#else
+
+#define InitializeInputLog()
+#define INPUT_LOG_TICK()
+#define INPUT_LOG_BUTTONS(car, cabin, floor)
+#define INPUT_LOG_REPEAT(ticks)
+
+#endif
+
+#endif /* INPUTLOG_H_ */
@@ -0,0 +1,264 @@
+/******************************************************************************
+* Program:   Lift simulation Basic Structure
+* Filename:  Keys.c
+* Version:   1.6
+* Date:      16.10.2026
+*
+* Description:
+* Button integrator debouncer and press/release/long press events, see
+* Keys.h.
+*
+* Required Libraries:
+* - avr/io.h, avr/interrupt.h
+* - Group.h
+* - LiftConfig.h
+* - InputLog.h
+*
+*******************************************************************************/
+
+/*** INCLUDE FILES ************************************************************/
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "Keys.h"
+#include "Group.h"         // CARS
+#include "LiftConfig.h"    // LIFT_PIND_BUTTONS()
+#include "InputLog.h"      // button record and replay
+
+#if CARS == 1 && FLOORS > LIFT_PIND_FLOORS
+#include "LiftGroup.h"     // LiftReadCarButtons()
+#endif
+
+
+/*** OWN DEFINES **************************************************************/
+#define FALSE               0
+#define TRUE                1
+
+#define PIND_READ           (CARS == 1 && FLOORS <= LIFT_PIND_FLOORS)
+
+
+/*** OWN DATA TYPES ***********************************************************/
+// debouncer of one button set
+typedef struct
+{
+	uint8_t                 integrator[FLOORS];
+	uint16_t                heldTicks[FLOORS];
+	CallMaskType            debounced;    // a set bit is a pressed button
+	volatile CallMaskType   busy;         // buttons that are still timing
+
+	// shared with the main loop
+	volatile CallMaskType   pressed;
+	volatile CallMaskType   released;
+	volatile CallMaskType   longPressed;
+	volatile CallMaskType   stuck;
+} KeyBankType;
+
+
+/*** GLOBAL Variablen *********************************************************/
+// sampled by the ISR only: the cabin buttons of every car, the floor buttons
+// once for the group
+static KeyBankType  cabinKeys[CARS];
+static KeyBankType  floorKeys;
+
+#if PIND_READ
+// PIND bits of the buttons of every floor
+#define CABIN_PIN(floor, cabin, hall)   cabin,
+#define FLOOR_PIN(floor, cabin, hall)   hall,
+static const uint8_t cabinPins[LIFT_PIND_FLOORS] = { LIFT_PIND_BUTTONS(CABIN_PIN) };
+static const uint8_t floorPins[LIFT_PIND_FLOORS] = { LIFT_PIND_BUTTONS(FLOOR_PIN) };
+#endif
+
+
+/*******************************************************************************
+***  PRIVATE FUNCTIONS  ********************************************************
+*******************************************************************************/
+// Buttons of a car, one bit per floor
+static void ReadButtons (uint8_t car, CallMaskType *cabin, CallMaskType *floor)
+{
+#if PIND_READ
+	uint8_t port = PIND;   // same polarity as ReadKeyEvent()
+
+	(void)car;
+	*cabin = 0;
+	*floor = 0;
+	for (uint8_t index = 0; index < FLOORS; index++)
+	{
+		if (port & cabinPins[index])
+		{
+			*cabin |= FLOOR_BIT(index);
+		}
+		if (port & floorPins[index])
+		{
+			*floor |= FLOOR_BIT(index);
+		}
+	}
+#else
+	uint64_t cabinButtons;
+	uint64_t floorButtons;
+
+	LiftReadCarButtons(car, &cabinButtons, &floorButtons);
+	*cabin = (CallMaskType)cabinButtons;
+	*floor = (CallMaskType)floorButtons;
+#endif
+}
+
+// Debounce one button set
+static uint8_t SampleBank (KeyBankType *bank, CallMaskType raw)
+{
+	uint8_t      changed = FALSE;
+	CallMaskType timing = 0;
+
+	// quick exit when no button is pressed, bouncing or timing
+	if (raw == bank->debounced && !bank->busy)
+	{
+		return FALSE;
+	}
+
+	for (uint8_t key = 0; key < FLOORS; key++)
+	{
+		CallMaskType bit = FLOOR_BIT(key);
+
+		if (raw & bit)
+		{
+			if (bank->integrator[key] < KEY_DEBOUNCE_TICKS)
+			{
+				bank->integrator[key]++;
+			}
+		}
+		else if (bank->integrator[key] > 0)
+		{
+			bank->integrator[key]--;
+		}
+
+		if (!(bank->debounced & bit) && bank->integrator[key] == KEY_DEBOUNCE_TICKS)
+		{
+			bank->debounced |= bit;
+			bank->pressed |= bit;
+			bank->heldTicks[key] = 0;
+			changed = TRUE;
+		}
+		else if ((bank->debounced & bit) && bank->integrator[key] == 0)
+		{
+			bank->debounced &= ~bit;
+			bank->released |= bit;
+			changed = TRUE;
+		}
+
+		// long press and stuck button: counted once per press
+		if ((bank->debounced & bit) && bank->heldTicks[key] < KEY_STUCK_TICKS)
+		{
+			if (++bank->heldTicks[key] == KEY_LONG_PRESS_TICKS)
+			{
+				bank->longPressed |= bit;
+				changed = TRUE;
+			}
+			else if (bank->heldTicks[key] == KEY_STUCK_TICKS)
+			{
+				bank->stuck |= bit;
+				changed = TRUE;
+			}
+		}
+
+		if ((bank->integrator[key] != 0 && bank->integrator[key] != KEY_DEBOUNCE_TICKS)
+		    || ((bank->debounced & bit) && bank->heldTicks[key] < KEY_STUCK_TICKS)
+		    || (((raw ^ bank->debounced) & bit) != 0))
+		{
+			timing |= bit;
+		}
+	}
+	bank->busy = timing;
+
+	return changed;
+}
+
+// Events of a button set are waiting or its buttons are timing
+static uint8_t BankActive (const KeyBankType *bank)
+{
+	return bank->busy || bank->pressed || bank->released || bank->longPressed || bank->stuck;
+}
+
+
+/*******************************************************************************
+***  PUBLIC FUNCTIONS  *********************************************************
+*******************************************************************************/
+// Sample the buttons
+uint8_t SampleKeys (void)
+{
+	uint8_t changed = FALSE;
+
+	INPUT_LOG_TICK();
+	for (uint8_t car = 0; car < CARS; car++)
+	{
+		CallMaskType cabin;
+		CallMaskType floor;
+
+		ReadButtons(car, &cabin, &floor);
+		INPUT_LOG_BUTTONS(car, &cabin, &floor);
+		changed |= SampleBank(&cabinKeys[car], cabin);
+		if (car == 0)
+		{
+			changed |= SampleBank(&floorKeys, floor);
+		}
+	}
+	return changed;
+}
+
+// Take the events of a car since the last call
+void TakeKeyEvents (uint8_t car, KeyEventsType *events)
+{
+	KeyBankType *cabin = &cabinKeys[car];
+
+	cli();
+	events->pressed.cabin     = cabin->pressed;
+	events->released.cabin    = cabin->released;
+	events->longPressed.cabin = cabin->longPressed;
+	events->stuck.cabin       = cabin->stuck;
+	cabin->pressed     = 0;
+	cabin->released    = 0;
+	cabin->longPressed = 0;
+	cabin->stuck       = 0;
+	if (car == 0)
+	{
+		events->pressed.floor     = floorKeys.pressed;
+		events->released.floor    = floorKeys.released;
+		events->longPressed.floor = floorKeys.longPressed;
+		events->stuck.floor       = floorKeys.stuck;
+		floorKeys.pressed     = 0;
+		floorKeys.released    = 0;
+		floorKeys.longPressed = 0;
+		floorKeys.stuck       = 0;
+	}
+	else
+	{
+		events->pressed.floor     = 0;
+		events->released.floor    = 0;
+		events->longPressed.floor = 0;
+		events->stuck.floor       = 0;
+	}
+	sei();
+}
+
+// No debouncing or long press timing in progress
+uint8_t KeysSettled (void)
+{
+	if (BankActive(&floorKeys))
+	{
+		return FALSE;
+	}
+	for (uint8_t car = 0; car < CARS; car++)
+	{
+		if (BankActive(&cabinKeys[car]))
+		{
+			return FALSE;
+		}
+	}
+	return TRUE;
+}
+
+#ifdef LIFT_SIM
+// Host simulation: settled buttons do not change the debouncer, only the
+// button log counts the ticks
+void RepeatKeySamples (uint32_t ticks)
+{
+	INPUT_LOG_REPEAT(ticks);
+}
+#endif
@@ -0,0 +1,98 @@
+/******************************************************************************
+* Program:   Lift simulation Basic Structure
+* Filename:  Keys.h
+* Version:   1.6
+* Date:      16.10.2026
+*
+* Description:
+* Button scan and debouncing. Buttons are identified by their floor: a
+* button set (KeySetType) has one bit per floor for the cabin buttons and
+* one for the floor buttons, like the call sets of the dispatcher. On the
+* board all eight buttons sit on PIND, so one port read gives the state of
+* every button; the PIND bit of each floor's buttons comes from
+* LIFT_PIND_BUTTONS (LiftConfig.h).
+*
+* The control tick ISR samples the buttons (SampleKeys()). Every button has
+* an integrator that counts up while the pin reads pressed and down while
+* it reads released; the debounced state only flips when the integrator
+* hits KEY_DEBOUNCE_MS or zero, so contact bounce shorter than that is
+* ignored. A flip is reported as a press or release event; a button held
+* for KEY_LONG_PRESS_MS also reports a long press, one held for
+* KEY_STUCK_MS is reported as stuck (Fault.h). Events are button sets, so
+* presses on several buttons are handled together.
+*
+* In a group (Group.h) every car has its own cabin buttons and debouncers;
+* the floor buttons are shared and debounced once. Shafts with more floors
+* than PIND has buttons for read them through the host library
+* (LiftGroup.h).
+*
+* The raw buttons of every tick pass the input log (InputLog.h), which
+* records them or replaces them with a recorded run.
+*
+* Precondition:  InitializePorts() has been called
+*
+* Postcondition: -
+*
+*******************************************************************************/
+#ifndef KEYS_H_
+#define KEYS_H_
+
+/*** INCLUDE FILES ************************************************************/
+#include <stdint.h>
+#include "ControlTick.h" // CONTROL_TICK_HZ
+#include "Dispatcher.h"  // CallMaskType, FLOORS
+
+
+/*** OWN DEFINES **************************************************************/
+#ifndef KEY_DEBOUNCE_MS
+#define KEY_DEBOUNCE_MS     5
+#endif
+#ifndef KEY_LONG_PRESS_MS
+#define KEY_LONG_PRESS_MS   1500
+#endif
+#ifndef KEY_STUCK_MS
+#define KEY_STUCK_MS        30000
+#endif
+
+#define KEY_DEBOUNCE_TICKS  (KEY_DEBOUNCE_MS * CONTROL_TICK_HZ / 1000)
+#define KEY_LONG_PRESS_TICKS (KEY_LONG_PRESS_MS * CONTROL_TICK_HZ / 1000)
+#define KEY_STUCK_TICKS     ((uint16_t)((uint32_t)KEY_STUCK_MS * CONTROL_TICK_HZ / 1000))
+
+
+/*** OWN DATA TYPES ***********************************************************/
+// one bit per floor
+typedef struct
+{
+	CallMaskType  cabin;
+	CallMaskType  floor;
+} KeySetType;
+
+typedef struct
+{
+	KeySetType  pressed;
+	KeySetType  released;
+	KeySetType  longPressed;
+	KeySetType  stuck;
+} KeyEventsType;
+
+
+/*** PUBLIC FUNCTIONS *********************************************************/
+// Sample the buttons, called by the control tick ISR.
+// Returns non-zero when a new event is waiting.
+uint8_t SampleKeys (void);
+
+// Take the events of a car since the last call; the floor buttons are
+// reported with car 0
+void TakeKeyEvents (uint8_t car, KeyEventsType *events);
+
+// No debouncing or long press timing in progress (nothing will change
+// until a pin changes)
+uint8_t KeysSettled (void);
+
+#ifdef LIFT_SIM
+// Host simulation: the same as this many SampleKeys() calls while the keys
+// are settled and no pin changes
+void RepeatKeySamples (uint32_t ticks);
+#endif
+
+#endif /* KEYS_H_ */
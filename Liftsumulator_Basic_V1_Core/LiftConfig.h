@@ -0,0 +1,69 @@
+/******************************************************************************
+* Program:   Lift simulation Basic Structure
+* Filename:  LiftConfig.h
+* Version:   1.1
+* Date:      16.10.2026
+*
+* Description:
+* Build time configuration of the shaft: number of floors, cabin positions
+* per floor and the buttons of the floors on PIND. Everything that depends
+* on the shaft (call sets, button tables, trip profile) is derived from
+* these values by the preprocessor, there is no table to edit by hand.
+*
+* The values can be overridden on the command line, e.g. make -B FLOORS=20;
+* the host build passes the same defines to the lift model (LiftLibrary_Host/
+* LiftGroup.h), which has the board's shaft by default.
+*
+* The library enumerates the special positions Error, Test and None right
+* after Floor3 (LiftLibrary.h). In a taller shaft those are floors, so the
+* controller uses LIFT_ERROR, LIFT_TEST and LIFT_NONE, which follow the
+* highest floor there and are the library values on the board.
+*
+* The ATmega32 board has four floors with 16 positions each; taller shafts
+* only run on the host simulation (up to 64 floors). There the floors above
+* the buttons of PIND are read through the host library (LiftGroup.h).
+*
+* Precondition:  -
+*
+* Postcondition: -
+*
+*******************************************************************************/
+#ifndef LIFTCONFIG_H_
+#define LIFTCONFIG_H_
+
+/*** OWN DEFINES **************************************************************/
+#ifndef LIFT_FLOORS
+#define LIFT_FLOORS             4
+#endif
+
+#ifndef LIFT_STEPS_PER_FLOOR
+#define LIFT_STEPS_PER_FLOOR    16
+#endif
+
+// buttons on PIND: X(floor, cabin button, floor button)
+#define LIFT_PIND_FLOORS        4
+#define LIFT_PIND_BUTTONS(X) \
+	X(0, LiftButton_F0, FloorButton_F0) \
+	X(1, LiftButton_F1, FloorButton_F1) \
+	X(2, LiftButton_F2, FloorButton_F2) \
+	X(3, LiftButton_F3, FloorButton_F3)
+
+// special positions beyond the floors
+#if LIFT_FLOORS <= 4
+#define LIFT_ERROR              Error
+#define LIFT_TEST               Test
+#define LIFT_NONE               None
+#else
+#define LIFT_ERROR              ((LiftPosType)LIFT_FLOORS)
+#define LIFT_TEST               ((LiftPosType)(LIFT_FLOORS + 2))
+#define LIFT_NONE               ((LiftPosType)(LIFT_FLOORS + 3))
+#endif
+
+#if LIFT_FLOORS < 2 || LIFT_FLOORS > 64
+#error "LIFT_FLOORS must be 2..64"
+#endif
+#if !defined(LIFT_SIM) && (LIFT_FLOORS != 4 || LIFT_STEPS_PER_FLOOR != 16)
+#error "the ATmega32 board has 4 floors with 16 positions each"
+#endif
+
+#endif /* LIFTCONFIG_H_ */
@@ -0,0 +1,234 @@
+/******************************************************************************
+* Program:   Lift simulation Basic Structure
+* Filename:  Outputs.c
+* Version:   1.4
+* Date:      16.10.2026
+*
+* Description:
+* Output shadow copies and SetOutput() pacing, see Outputs.h. Every car of
+* the group has shadow copies of its own.
+*
+* Required Libraries:
+* - LiftLibrary.h
+* - ControlTick.h
+* - Group.h
+*
+*******************************************************************************/
+
+/*** INCLUDE FILES ************************************************************/
+#include "ControlTick.h" // OUTPUTS_PER_TICK
+#include "Dispatcher.h"  // FLOORS, FLOOR_BIT()
+#include "Outputs.h"
+#include "Group.h"       // currentCar
+
+#ifdef LIFT_SIM
+#include <stdio.h>
+#include <stdlib.h>
+#endif
+
+
+/*** OWN DEFINES **************************************************************/
+#define FALSE               0
+#define TRUE                1
+#define UNKNOWN             0xFF
+
+
+/*** OWN DATA TYPES ***********************************************************/
+// what the library of a car was told last
+typedef struct
+{
+	uint8_t      shownDisplay;
+	CallMaskType shownCabin;             // indicators that are on
+	CallMaskType shownFloor;
+	uint8_t      requestedDoor[FLOORS];
+	LiftPosType  movingDoor;             // door that still needs pacing
+} ShadowType;
+
+
+/*** GLOBAL Variablen *********************************************************/
+static ShadowType       shadows[CARS];
+
+static OutputStatsType  stats;
+
+
+/*******************************************************************************
+***  PRIVATE FUNCTIONS  ********************************************************
+*******************************************************************************/
+#ifdef LIFT_SIM
+// Host simulation: print the counters at the end of the run
+static void ReportOutputs (void)
+{
+	uint32_t total = stats.written + stats.skipped;
+
+	fprintf(stderr, "outputs: %lu library output calls, %lu skipped (%.1f %%)\n",
+	        (unsigned long)stats.written, (unsigned long)stats.skipped,
+	        total ? 100.0 * stats.skipped / total : 0.0);
+}
+#endif
+
+
+/*******************************************************************************
+***  PUBLIC FUNCTIONS  *********************************************************
+*******************************************************************************/
+// Reset the shadow copies
+void InitializeOutputs (void)
+{
+	for (uint8_t car = 0; car < CARS; car++)
+	{
+		ShadowType *shadow = &shadows[car];
+
+		shadow->shownDisplay    = UNKNOWN;
+		shadow->shownCabin      = 0;      // InitializeStart() clears the indicators
+		shadow->shownFloor      = 0;
+		shadow->movingDoor      = LIFT_NONE;
+		for (uint8_t floor = 0; floor < FLOORS; floor++)
+		{
+			shadow->requestedDoor[floor] = UNKNOWN;
+		}
+	}
+
+#ifdef LIFT_SIM
+	atexit(ReportOutputs);
+#endif
+}
+
+// 7-segment display of the cabin
+void WriteDisplay (LiftPosType value)
+{
+	ShadowType *shadow = &shadows[currentCar];
+
+	if (value == shadow->shownDisplay)
+	{
+		stats.skipped++;
+		return;
+	}
+	SetDisplay(value);
+	shadow->shownDisplay = value;
+	stats.written++;
+}
+
+// Call indicator of a cabin or floor button
+void WriteIndicator (LiftPosType floor, uint8_t cabin)
+{
+	ShadowType   *shadow = &shadows[currentCar];
+	CallMaskType *shown = cabin ? &shadow->shownCabin : &shadow->shownFloor;
+
+	if (*shown & FLOOR_BIT(floor))
+	{
+		stats.skipped++;
+		return;
+	}
+	cabin ? SetIndicatorElevatorState(floor) : SetIndicatorFloorState(floor);
+	*shown |= FLOOR_BIT(floor);
+	stats.written++;
+}
+
+// Both call indicators of a floor off
+void ClearIndicators (LiftPosType floor)
+{
+	ShadowType *shadow = &shadows[currentCar];
+
+	if (shadow->shownFloor & FLOOR_BIT(floor))
+	{
+		ClrIndicatorFloorState(floor);
+		stats.written++;
+	}
+	else
+	{
+		stats.skipped++;
+	}
+
+	if (shadow->shownCabin & FLOOR_BIT(floor))
+	{
+		ClrIndicatorElevatorState(floor);
+		stats.written++;
+	}
+	else
+	{
+		stats.skipped++;
+	}
+	shadow->shownFloor &= ~FLOOR_BIT(floor);
+	shadow->shownCabin &= ~FLOOR_BIT(floor);
+}
+
+// Call indicator of the cabin button of a floor off
+void ClearCabinIndicator (LiftPosType floor)
+{
+	ShadowType *shadow = &shadows[currentCar];
+
+	if (shadow->shownCabin & FLOOR_BIT(floor))
+	{
+		ClrIndicatorElevatorState(floor);
+		shadow->shownCabin &= ~FLOOR_BIT(floor);
+		stats.written++;
+	}
+	else
+	{
+		stats.skipped++;
+	}
+}
+
+// Call indicator of the floor button of a floor off
+void ClearHallIndicator (LiftPosType floor)
+{
+	ShadowType *shadow = &shadows[currentCar];
+
+	if (shadow->shownFloor & FLOOR_BIT(floor))
+	{
+		ClrIndicatorFloorState(floor);
+		shadow->shownFloor &= ~FLOOR_BIT(floor);
+		stats.written++;
+	}
+	else
+	{
+		stats.skipped++;
+	}
+}
+
+// Door request of a floor
+void WriteDoorState (DoorStateType state, LiftPosType floor)
+{
+	ShadowType *shadow = &shadows[currentCar];
+
+	if (shadow->requestedDoor[floor] == state)
+	{
+		stats.skipped++;
+		return;
+	}
+	SetDoorState(state, floor);
+	shadow->requestedDoor[floor] = state;
+	shadow->movingDoor = floor;
+	stats.written++;
+}
+
+// SetOutput() calls for this many control ticks
+void RefreshOutputs (uint8_t ticks)
+{
+	ShadowType *shadow = &shadows[currentCar];
+	uint16_t   calls = OUTPUTS_IDLE_PER_TICK * ticks;
+
+	if (shadow->movingDoor != LIFT_NONE)
+	{
+		if (ReadDoorState(shadow->movingDoor) == shadow->requestedDoor[shadow->movingDoor])
+		{
+			shadow->movingDoor = LIFT_NONE;
+		}
+		else
+		{
+			calls = OUTPUTS_PER_TICK * ticks;
+		}
+	}
+
+	for (uint16_t i = 0; i < calls; i++)
+	{
+		SetOutput();
+	}
+	stats.written += calls;
+	stats.skipped += OUTPUTS_PER_TICK * ticks - calls;
+}
+
+// Counters of written and skipped calls
+const OutputStatsType *GetOutputStats (void)
+{
+	return &stats;
+}
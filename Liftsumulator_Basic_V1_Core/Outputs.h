@@ -0,0 +1,74 @@
+/******************************************************************************
+* Program:   Lift simulation Basic Structure
+* Filename:  Outputs.h
+* Version:   1.2
+* Date:      16.10.2026
+*
+* Description:
+* Shadow copies of the output values handed to the library. A setter only
+* calls the library when the value differs from the shadow, so the display,
+* the call indicators and the door requests are written once per change
+* instead of on every loop pass.
+*
+* SetOutput() multiplexes the LEDs and doors over the shared ports and
+* paces the doors (one step per 5000 calls), so it cannot be skipped
+* altogether: while a door moves it runs OUTPUTS_PER_TICK times per tick,
+* otherwise OUTPUTS_IDLE_PER_TICK times, which is enough to keep the
+* multiplexed LEDs lit.
+*
+* All functions refer to the car selected with SelectCar() (Group.h).
+*
+* Precondition:  InitializeStart() has been called
+*
+* Postcondition: -
+*
+*******************************************************************************/
+#ifndef OUTPUTS_H_
+#define OUTPUTS_H_
+
+/*** INCLUDE FILES ************************************************************/
+#include <stdint.h>
+#include "LiftLibrary.h" // lift model library
+
+
+/*** OWN DEFINES **************************************************************/
+#define OUTPUTS_IDLE_PER_TICK   1
+
+
+/*** OWN DATA TYPES ***********************************************************/
+typedef struct
+{
+	uint32_t  written;   // library output calls made
+	uint32_t  skipped;   // calls saved by the shadow copies
+} OutputStatsType;
+
+
+/*** PUBLIC FUNCTIONS *********************************************************/
+// Reset the shadow copies
+void InitializeOutputs (void);
+
+// 7-segment display of the cabin
+void WriteDisplay (LiftPosType value);
+
+// Call indicator of a cabin (cabin = TRUE) or floor button
+void WriteIndicator (LiftPosType floor, uint8_t cabin);
+
+// Both call indicators of a floor off
+void ClearIndicators (LiftPosType floor);
+
+// Call indicator of the cabin button of a floor off
+void ClearCabinIndicator (LiftPosType floor);
+
+// Call indicator of the floor button of a floor off
+void ClearHallIndicator (LiftPosType floor);
+
+// Door request of a floor
+void WriteDoorState (DoorStateType state, LiftPosType floor);
+
+// SetOutput() calls for this many control ticks
+void RefreshOutputs (uint8_t ticks);
+
+// Counters of written and skipped calls
+const OutputStatsType *GetOutputStats (void);
+
+#endif /* OUTPUTS_H_ */